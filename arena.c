@@ -0,0 +1,106 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdlib.h>
+#include "arena.h"
+
+#define ARENA_BLOCK_SIZE (1024 * 1024)
+#define ARENA_ALIGN 16
+
+/*
+* Struct Definition
+*/
+struct ArenaBlock {
+    ArenaBlock *next;
+    size_t used;
+    size_t capacity;
+    // Allocations follow the header, aligned to ARENA_ALIGN
+};
+
+/*
+* Function Prototypes
+*/
+static size_t arena_align(size_t size);
+
+/* void init_arena(Arena *arena)
+* -----------------------------------------------
+* Initialises an empty arena
+*
+* arena: the arena to initialise
+*
+* Returns: -
+* Errors: -
+*/
+void init_arena(Arena *arena)
+{
+    arena->blocks = 0;
+    arena->blockCount = 0;
+}
+
+/* void *arena_alloc(Arena *arena, size_t size)
+* -----------------------------------------------
+* Allocates size bytes from the arena. A new block is only malloc()ed when
+* the current one is full, so a whole query needs a handful of allocations
+* however many words it returns.
+*
+* arena: the arena to allocate from
+* size: number of bytes needed
+*
+* Returns: pointer to the allocated memory, aligned to ARENA_ALIGN
+* Errors: aborts if memory cannot be allocated
+*/
+void *arena_alloc(Arena *arena, size_t size)
+{
+    size = arena_align(size);
+    ArenaBlock *block = arena->blocks;
+    if (block == 0 || block->capacity - block->used < size) {
+        size_t capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        block = malloc(arena_align(sizeof(ArenaBlock)) + capacity);
+        if (block == 0) {
+            abort();
+        }
+        block->next = arena->blocks;
+        block->used = 0;
+        block->capacity = capacity;
+        arena->blocks = block;
+        arena->blockCount++;
+    }
+    void *memory = (char *) block + arena_align(sizeof(ArenaBlock))
+            + block->used;
+    block->used += size;
+    return memory;
+}
+
+/* void free_arena(Arena *arena)
+* -----------------------------------------------
+* Releases every allocation made from the arena
+*
+* arena: the arena to release
+*
+* Returns: -
+* Errors: -
+*/
+void free_arena(Arena *arena)
+{
+    ArenaBlock *block = arena->blocks;
+    while (block) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    init_arena(arena);
+}
+
+/* static size_t arena_align(size_t size)
+* -----------------------------------------------
+* Rounds size up to a multiple of ARENA_ALIGN
+*
+* size: size to be rounded
+*
+* Returns: the rounded size
+* Errors: -
+*/
+static size_t arena_align(size_t size)
+{
+    return (size + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+}
@@ -0,0 +1,28 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+* Struct Definitions
+*/
+typedef struct ArenaBlock ArenaBlock;
+
+// Bump allocator: allocations are carved out of large blocks and are all
+// released together by free_arena()
+typedef struct {
+    ArenaBlock *blocks;
+    size_t blockCount;
+} Arena;
+
+/*
+* Function Prototypes
+*/
+void init_arena(Arena *arena);
+void *arena_alloc(Arena *arena, size_t size);
+void free_arena(Arena *arena);
+
+#endif
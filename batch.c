@@ -0,0 +1,155 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "batch.h"
+#include "wordindex.h"
+#include "bitsetindex.h"
+#include "scan.h"
+#include "query.h"
+#include "output.h"
+
+// Each line of a batch is one query, in the same form as a -serve query.
+// Blank lines are skipped and get no answer.
+// The answer to every query is written in input order: what the command
+// line tool would print for it (the matching words, or its error message),
+// followed by the exit status it would have returned, one record each in
+// the output format (see output.h).
+
+// Queries are read and answered this many at a time
+#define BATCH_WINDOW 256
+
+/*
+* Struct Definition
+*/
+typedef struct {
+    WordleArguments args;
+    ScanFilter filter;
+    uint64_t *matches;
+} BatchQuery;
+
+/*
+* Function Prototypes
+*/
+static void run_batch_window(const WordIndex *index, BatchQuery *queries,
+        int count, int threads, OutputWriter *out);
+
+/* int run_batch(const char *batchPath, int threads, int format)
+* -----------------------------------------------
+* Answers every query in a batch file against a single loaded dictionary.
+* The -threads value of each query is checked but ignored; the whole batch
+* runs with the given number of threads.
+*
+* batchPath: file holding one query per line, or "-" for stdin
+* threads: number of threads to scan with
+* format: output format of the answers, unless a query picks its own
+*
+* Returns: 0 once every query has been answered, or BATCH_ERROR_STATUS if
+*          the batch file cannot be opened
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+int run_batch(const char *batchPath, int threads, int format)
+{
+    FILE *in = strcmp(batchPath, "-") == 0 ? stdin : fopen(batchPath, "r");
+    if (in == 0) {
+        fprintf(stderr, "wordle-helper: batch file \"%s\" cannot be opened\n",
+                batchPath);
+        return BATCH_ERROR_STATUS;
+    }
+    WordIndex *index = open_word_index(0);
+    OutputWriter out;
+    init_output_writer(&out, STDOUT_FILENO, format);
+    BatchQuery *queries = malloc(BATCH_WINDOW * sizeof(BatchQuery));
+    int count = 0;
+    char *line = 0;
+    size_t size = 0;
+    while (getline(&line, &size, in) >= 0) {
+        if (line[strspn(line, " \t\r\n")] == '\0') {
+            continue; // not a query with no arguments
+        }
+        queries[count++].args = parse_query_line(line);
+        if (count == BATCH_WINDOW) {
+            run_batch_window(index, queries, count, threads, &out);
+            count = 0;
+        }
+    }
+    run_batch_window(index, queries, count, threads, &out);
+    free_output_writer(&out);
+    free(line);
+    free(queries);
+    if (in != stdin) {
+        fclose(in);
+    }
+    close_word_index(index);
+    return 0;
+}
+
+/* static void run_batch_window(const WordIndex *index, BatchQuery *queries,
+*        int count, int threads, OutputWriter *out)
+* -----------------------------------------------
+* Answers a window of parsed queries. The queries are grouped by -len so
+* each length bucket is scanned once for the whole group, every query's
+* filter being applied to a segment of the bucket while it is in cache.
+* The answers are then printed in input order.
+*
+* index: the dictionary index
+* queries: the parsed queries
+* count: number of queries
+* threads: number of threads to scan with
+* out: where the answers are written
+*
+* Returns: -
+* Errors: -
+*/
+static void run_batch_window(const WordIndex *index, BatchQuery *queries,
+        int count, int threads, OutputWriter *out)
+{
+    int format = out->format;
+    ScanFilter filters[BATCH_WINDOW];
+    uint64_t *results[BATCH_WINDOW];
+    for (int len = MIN_LEN; len <= MAX_LEN; len++) {
+        const WordBucket *bucket = get_word_bucket(index, len);
+        int groupSize = 0;
+        for (int i = 0; i < count; i++) {
+            WordleArguments *args = &queries[i].args;
+            if (args->status || args->len != len) {
+                continue;
+            }
+            compile_scan_filter(bucket,
+                    args->patternFlag ? args->patternString : 0,
+                    args->withFlag ? args->withString : "",
+                    args->withoutFlag ? args->withoutString : "",
+                    args->feedbackFlag ? &args->feedback : 0,
+                    &queries[i].filter);
+            order_scan_filter(bucket, &queries[i].filter);
+            queries[i].matches = malloc(get_bitset_words(bucket->count)
+                    * sizeof(uint64_t));
+            filters[groupSize] = queries[i].filter;
+            results[groupSize++] = queries[i].matches;
+        }
+        if (groupSize > 0) {
+            filter_bucket_group(bucket, filters, groupSize, threads,
+                    results);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        WordleArguments *args = &queries[i].args;
+        int status = args->status;
+        if (!status) {
+            CandidateList candidates;
+            if (args->formatFlag) {
+                out->format = args->format;
+            }
+            collect_candidates(get_word_bucket(index, args->len),
+                    &queries[i].filter, queries[i].matches, &candidates);
+            status = print_candidates(&candidates, args, out);
+            free_candidates(&candidates);
+            free(queries[i].matches);
+        }
+        write_answer_end(args, status, out);
+        out->format = format;
+    }
+}
@@ -0,0 +1,15 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef BATCH_H
+#define BATCH_H
+
+// Exit code of -batch when the batch file cannot be opened
+#define BATCH_ERROR_STATUS 5
+
+/*
+* Function Prototypes
+*/
+int run_batch(const char *batchPath, int threads, int format);
+
+#endif
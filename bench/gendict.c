@@ -0,0 +1,305 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/*
+* ./gendict [-words count ] [-seed seed ] [-lengths min-max ] \
+* [-length-dist uniform|english ] [-letters uniform|english|zipf ] \
+* [-duplicates percent ] [-noise percent ] [-capitals percent ]
+*
+* Writes a synthetic dictionary to stdout, one word per line. The same
+* arguments always produce the same dictionary.
+*/
+
+#define USAGE "Usage: gendict [-words count] [-seed seed] [-lengths min-max] " \
+        "[-length-dist uniform|english] [-letters uniform|english|zipf] " \
+        "[-duplicates percent] [-noise percent] [-capitals percent]\n"
+#define ALPHABET_SIZE 26
+#define MAX_WORD_LEN 32
+// Earlier words a duplicate is picked from
+#define RECENT_WORDS 4096
+
+#define DIST_UNIFORM 0
+#define DIST_ENGLISH 1
+#define DIST_ZIPF 2
+
+/*
+* Struct Definition
+*/
+typedef struct {
+    long words;
+    uint64_t seed;
+    int minLen, maxLen;
+    int lengthDist, letterDist;
+    double duplicates, noise, capitals;
+} GeneratorOptions;
+
+// Relative frequency of each letter in English text, per mille
+static const double englishLetters[ALPHABET_SIZE] = {
+    82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24,
+    67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1
+};
+
+// Relative number of dictionary words of each length, per mille
+static const double englishLengths[MAX_WORD_LEN + 1] = {
+    0, 1, 5, 20, 45, 80, 115, 135, 140, 130, 110, 85, 60, 40, 25, 15, 10,
+    6, 4, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+};
+
+// Characters that make a word non-alphabetic
+static const char noiseCharacters[] = "'-.0123456789&/";
+
+/*
+* Function Prototypes
+*/
+static GeneratorOptions parse_options(int argc, char *argv[]);
+static int parse_percent(const char *arg, double *value);
+static void usage_error(void);
+static uint64_t next_random(uint64_t *state);
+static double next_unit(uint64_t *state);
+static void build_cumulative(const double *weights, int first, int last,
+        double *cumulative);
+static int pick(const double *cumulative, int first, int last,
+        uint64_t *state);
+
+/* int main(int argc, char *argv[])
+* -----------------------------------------------
+* Generates the dictionary
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings
+*
+* Returns: 0
+* Errors: exits with code 1 if the arguments are invalid
+*/
+int main(int argc, char *argv[])
+{
+    GeneratorOptions options = parse_options(argc, argv);
+    uint64_t state = options.seed * 0x9E3779B97F4A7C15ull + 1;
+    double letters[ALPHABET_SIZE], lengths[MAX_WORD_LEN + 1];
+    double letterWeights[ALPHABET_SIZE], lengthWeights[MAX_WORD_LEN + 1];
+    for (int i = 0; i < ALPHABET_SIZE; i++) {
+        letterWeights[i] = options.letterDist == DIST_ENGLISH
+                ? englishLetters[i]
+                : options.letterDist == DIST_ZIPF ? 1.0 / (i + 1) : 1;
+    }
+    for (int i = 0; i <= MAX_WORD_LEN; i++) {
+        lengthWeights[i] = options.lengthDist == DIST_ENGLISH
+                ? englishLengths[i] : 1;
+    }
+    build_cumulative(letterWeights, 0, ALPHABET_SIZE - 1, letters);
+    build_cumulative(lengthWeights, options.minLen, options.maxLen, lengths);
+    static char recent[RECENT_WORDS][MAX_WORD_LEN + 2];
+    long recentCount = 0;
+    char word[MAX_WORD_LEN + 2];
+    for (long n = 0; n < options.words; n++) {
+        if (recentCount && next_unit(&state) * 100 < options.duplicates) {
+            long limit = recentCount < RECENT_WORDS ? recentCount
+                    : RECENT_WORDS;
+            fputs(recent[next_random(&state) % limit], stdout);
+            continue;
+        }
+        int len = pick(lengths, options.minLen, options.maxLen, &state);
+        for (int i = 0; i < len; i++) {
+            word[i] = 'a' + pick(letters, 0, ALPHABET_SIZE - 1, &state);
+        }
+        if (next_unit(&state) * 100 < options.capitals) {
+            word[0] -= 'a' - 'A';
+        }
+        if (next_unit(&state) * 100 < options.noise) {
+            word[next_random(&state) % len] = noiseCharacters[
+                    next_random(&state) % (sizeof(noiseCharacters) - 1)];
+        }
+        word[len] = '\n';
+        word[len + 1] = '\0';
+        memcpy(recent[recentCount++ % RECENT_WORDS], word, len + 2);
+        fputs(word, stdout);
+    }
+    return 0;
+}
+
+/* static GeneratorOptions parse_options(int argc, char *argv[])
+* -----------------------------------------------
+* Parses the commandline arguments, filling in defaults for those not given
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings
+*
+* Returns: the options
+* Errors: exits with code 1 if an argument is unknown, is missing its value
+* or has an invalid value
+*/
+static GeneratorOptions parse_options(int argc, char *argv[])
+{
+    GeneratorOptions options = {100000, 1, 2, 14, DIST_ENGLISH, DIST_ENGLISH,
+            5, 2, 10};
+    for (int i = 1; i < argc; i++) {
+        const char *value = argv[i + 1];
+        char *end;
+        if (value == 0) {
+            usage_error();
+        } else if (strcmp(argv[i], "-words") == 0) {
+            options.words = strtol(value, &end, 10);
+            if (*end || options.words < 0) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-seed") == 0) {
+            options.seed = strtoull(value, &end, 10);
+            if (*end) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-lengths") == 0) {
+            if (sscanf(value, "%d-%d", &options.minLen, &options.maxLen) != 2
+                    || options.minLen < 1 || options.maxLen > MAX_WORD_LEN
+                    || options.minLen > options.maxLen) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-length-dist") == 0) {
+            if (strcmp(value, "uniform") == 0) {
+                options.lengthDist = DIST_UNIFORM;
+            } else if (strcmp(value, "english") != 0) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-letters") == 0) {
+            if (strcmp(value, "uniform") == 0) {
+                options.letterDist = DIST_UNIFORM;
+            } else if (strcmp(value, "zipf") == 0) {
+                options.letterDist = DIST_ZIPF;
+            } else if (strcmp(value, "english") != 0) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-duplicates") == 0) {
+            if (!parse_percent(value, &options.duplicates)) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-noise") == 0) {
+            if (!parse_percent(value, &options.noise)) {
+                usage_error();
+            }
+        } else if (strcmp(argv[i], "-capitals") == 0) {
+            if (!parse_percent(value, &options.capitals)) {
+                usage_error();
+            }
+        } else {
+            usage_error();
+        }
+        i++;
+    }
+    return options;
+}
+
+/* static int parse_percent(const char *arg, double *value)
+* -----------------------------------------------
+* Parses a percentage between 0 and 100
+*
+* arg: the argument
+* value: receives the percentage
+*
+* Returns: 1 if the argument is a valid percentage, 0 otherwise
+* Errors: -
+*/
+static int parse_percent(const char *arg, double *value)
+{
+    char *end;
+    *value = strtod(arg, &end);
+    return end != arg && *end == '\0' && *value >= 0 && *value <= 100;
+}
+
+/* static void usage_error(void)
+* -----------------------------------------------
+* Prints the usage message and exits
+*
+* Returns: -
+* Errors: exits with code 1
+*/
+static void usage_error(void)
+{
+    fprintf(stderr, USAGE);
+    exit(1);
+}
+
+/* static uint64_t next_random(uint64_t *state)
+* -----------------------------------------------
+* xorshift64* generator: fast, and the same on every platform
+*
+* state: generator state, never 0
+*
+* Returns: the next pseudo random number
+* Errors: -
+*/
+static uint64_t next_random(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1Dull;
+}
+
+/* static double next_unit(uint64_t *state)
+* -----------------------------------------------
+* Draws a pseudo random number in [0, 1)
+*
+* state: generator state
+*
+* Returns: the number
+* Errors: -
+*/
+static double next_unit(uint64_t *state)
+{
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* static void build_cumulative(const double *weights, int first, int last,
+*        double *cumulative)
+* -----------------------------------------------
+* Turns the weights of first..last into a cumulative distribution
+*
+* weights: relative weight of every value
+* first, last: range of values to draw from
+* cumulative: receives the distribution, indexed like weights
+*
+* Returns: -
+* Errors: -
+*/
+static void build_cumulative(const double *weights, int first, int last,
+        double *cumulative)
+{
+    double total = 0;
+    for (int i = first; i <= last; i++) {
+        total += weights[i];
+    }
+    double sum = 0;
+    for (int i = first; i <= last; i++) {
+        sum += weights[i];
+        cumulative[i] = total > 0 ? sum / total : (double) (i - first + 1)
+                / (last - first + 1);
+    }
+}
+
+/* static int pick(const double *cumulative, int first, int last,
+*        uint64_t *state)
+* -----------------------------------------------
+* Draws a value from a cumulative distribution
+*
+* cumulative: the distribution built by build_cumulative()
+* first, last: range of values
+* state: generator state
+*
+* Returns: the value
+* Errors: -
+*/
+static int pick(const double *cumulative, int first, int last,
+        uint64_t *state)
+{
+    double u = next_unit(state);
+    for (int i = first; i < last; i++) {
+        if (u < cumulative[i]) {
+            return i;
+        }
+    }
+    return last;
+}
@@ -0,0 +1,484 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/*
+* ./harness -bin program -dict dictionary -queries file [-runs count ] \
+* [-threads count ] [-cache dir ] [-out file ] [-baseline file ] \
+* [-tolerance percent ]
+*
+* Runs every query of the corpus against the dictionary a number of times
+* with -stats json, and writes one JSON object per query (latency
+* percentiles of every stage) plus a summary object, one per line, to the
+* results file. With a baseline the results are compared against it and
+* the harness fails if any query got slower by more than the tolerance.
+*/
+
+#define USAGE "Usage: harness -bin program -dict dictionary -queries file " \
+        "[-runs count] [-threads count] [-cache dir] [-out file] " \
+        "[-baseline file] [-tolerance percent]\n"
+#define MAX_QUERY_SIZE 1024
+#define MAX_QUERY_ARGS 64
+#define MAX_STATS_SIZE 4096
+#define NS_PER_MS 1000000.0
+
+// The stages reported by -stats json, plus the wall clock time of the run
+// as seen from outside the process
+#define STAGE_COUNT 9
+static const char *const stageNames[STAGE_COUNT] = {
+    "wall", "total", "parse", "index_read", "index_build", "index_write",
+    "scan", "sort", "output"
+};
+static const double percentiles[] = {50, 90, 99};
+#define PERCENTILE_COUNT 3
+
+/*
+* Struct Definitions
+*/
+typedef struct {
+    const char *bin, *dict, *queries, *cache, *out, *baseline;
+    int runs, threads;
+    double tolerance;
+} HarnessOptions;
+
+// Samples of one query: samples[stage][run], in milliseconds
+typedef struct {
+    double *samples[STAGE_COUNT];
+    long matches;
+} QueryResult;
+
+/*
+* Function Prototypes
+*/
+static HarnessOptions parse_options(int argc, char *argv[]);
+static void usage_error(void);
+static uint64_t get_monotonic_ns(void);
+static int run_query(const HarnessOptions *options, char *query,
+        QueryResult *result, int run);
+static double get_stats_value(const char *stats, const char *name);
+static int compare_doubles(const void *a, const void *b);
+static double get_percentile(double *samples, int count, double percentile);
+static void write_query_result(FILE *out, const char *query,
+        QueryResult *result, int runs);
+static void write_json_string(FILE *out, const char *s);
+static int compare_with_baseline(const char *resultsPath,
+        const char *baselinePath, double tolerance);
+static int find_query_p50(const char *line, const char *stage,
+        char *query, size_t size, double *p50);
+
+/* int main(int argc, char *argv[])
+* -----------------------------------------------
+* Runs the benchmark
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings
+*
+* Returns: 0 on success, 2 if a query regressed against the baseline
+* Errors: exits with code 1 if the arguments are invalid, or 3 if the
+* corpus, results or program cannot be used
+*/
+int main(int argc, char *argv[])
+{
+    HarnessOptions options = parse_options(argc, argv);
+    FILE *queries = fopen(options.queries, "r");
+    FILE *out = options.out ? fopen(options.out, "w") : stdout;
+    if (queries == 0 || out == 0) {
+        fprintf(stderr, "harness: unable to open the corpus or results\n");
+        return 3;
+    }
+    setenv("WORDLE_DICTIONARY", options.dict, 1);
+    mkdir(options.cache, 0755);
+    setenv("WORDLE_CACHE_DIR", options.cache, 1);
+    char line[MAX_QUERY_SIZE], query[MAX_QUERY_SIZE];
+    QueryResult result;
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        result.samples[stage] = malloc(options.runs * sizeof(double));
+    }
+    // Builds the cached index, so every measured run reads it
+    strcpy(query, "-len 5 ZZZZZ");
+    if (run_query(&options, query, &result, 0) != 0) {
+        fprintf(stderr, "harness: unable to run \"%s\"\n", options.bin);
+        return 3;
+    }
+    double allWall = 0;
+    long queryCount = 0;
+    int failed = 0;
+    while (fgets(line, sizeof(line), queries)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[strspn(line, " \t")] == '\0') {
+            continue;
+        }
+        for (int run = 0; run < options.runs && !failed; run++) {
+            strcpy(query, line);
+            failed = run_query(&options, query, &result, run);
+            allWall += result.samples[0][run];
+        }
+        if (failed) {
+            fprintf(stderr, "harness: query \"%s\" failed\n", line);
+            return 3;
+        }
+        write_query_result(out, line, &result, options.runs);
+        queryCount++;
+    }
+    fprintf(out, "{\"summary\": true, \"dictionary\": ");
+    write_json_string(out, options.dict);
+    fprintf(out, ", \"queries\": %ld, \"runs\": %d, \"threads\": %d, "
+            "\"throughput_qps\": %.1f}\n", queryCount, options.runs,
+            options.threads,
+            allWall > 0 ? queryCount * options.runs / (allWall / 1000) : 0);
+    fclose(queries);
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (options.baseline && options.out) {
+        return compare_with_baseline(options.out, options.baseline,
+                options.tolerance) ? 2 : 0;
+    }
+    return 0;
+}
+
+/* static HarnessOptions parse_options(int argc, char *argv[])
+* -----------------------------------------------
+* Parses the commandline arguments, filling in defaults for those not given
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings
+*
+* Returns: the options
+* Errors: exits with code 1 if an argument is unknown, is missing its value
+* or -bin, -dict or -queries is not given
+*/
+static HarnessOptions parse_options(int argc, char *argv[])
+{
+    HarnessOptions options = {0, 0, 0, "bench/cache", 0, 0, 10, 0, 10};
+    for (int i = 1; i < argc; i += 2) {
+        const char *value = argv[i + 1];
+        if (value == 0) {
+            usage_error();
+        } else if (strcmp(argv[i], "-bin") == 0) {
+            options.bin = value;
+        } else if (strcmp(argv[i], "-dict") == 0) {
+            options.dict = value;
+        } else if (strcmp(argv[i], "-queries") == 0) {
+            options.queries = value;
+        } else if (strcmp(argv[i], "-cache") == 0) {
+            options.cache = value;
+        } else if (strcmp(argv[i], "-out") == 0) {
+            options.out = value;
+        } else if (strcmp(argv[i], "-baseline") == 0) {
+            options.baseline = value;
+        } else if (strcmp(argv[i], "-runs") == 0) {
+            options.runs = atoi(value);
+        } else if (strcmp(argv[i], "-threads") == 0) {
+            options.threads = atoi(value);
+        } else if (strcmp(argv[i], "-tolerance") == 0) {
+            options.tolerance = atof(value);
+        } else {
+            usage_error();
+        }
+    }
+    if (!options.bin || !options.dict || !options.queries || options.runs < 1
+            || options.threads < 0 || options.tolerance < 0) {
+        usage_error();
+    }
+    return options;
+}
+
+/* static void usage_error(void)
+* -----------------------------------------------
+* Prints the usage message and exits
+*
+* Returns: -
+* Errors: exits with code 1
+*/
+static void usage_error(void)
+{
+    fprintf(stderr, USAGE);
+    exit(1);
+}
+
+/* static uint64_t get_monotonic_ns(void)
+* -----------------------------------------------
+* Reads the monotonic clock
+*
+* Returns: the time in nanoseconds since an arbitrary starting point
+* Errors: -
+*/
+static uint64_t get_monotonic_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+/* static int run_query(const HarnessOptions *options, char *query,
+*        QueryResult *result, int run)
+* -----------------------------------------------
+* Runs the program once for a query, with its output discarded and its
+* statistics collected
+*
+* options: the harness options
+* query: the query's arguments, split up in place
+* result: the run's samples are stored in it
+* run: number of the run
+*
+* Returns: 0 on success, -1 if the program could not be run or failed
+* Errors: -
+*/
+static int run_query(const HarnessOptions *options, char *query,
+        QueryResult *result, int run)
+{
+    char *argv[MAX_QUERY_ARGS + 6];
+    char threads[16];
+    int argc = 0;
+    argv[argc++] = (char *) options->bin;
+    argv[argc++] = "-stats";
+    argv[argc++] = "json";
+    if (options->threads) {
+        snprintf(threads, sizeof(threads), "%d", options->threads);
+        argv[argc++] = "-threads";
+        argv[argc++] = threads;
+    }
+    for (char *arg = strtok(query, " \t"); arg && argc < MAX_QUERY_ARGS;
+            arg = strtok(0, " \t")) {
+        argv[argc++] = arg;
+    }
+    argv[argc] = 0;
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    uint64_t start = get_monotonic_ns();
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        dup2(fds[1], STDERR_FILENO);
+        close(fds[0]);
+        execv(options->bin, argv);
+        _exit(127);
+    }
+    close(fds[1]);
+    char stats[MAX_STATS_SIZE];
+    size_t used = 0;
+    ssize_t got;
+    while ((got = read(fds[0], stats + used, sizeof(stats) - 1 - used)) > 0) {
+        used += got;
+    }
+    stats[used] = '\0';
+    close(fds[0]);
+    int status;
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status)
+            || (WEXITSTATUS(status) != 0 && WEXITSTATUS(status) != 4)) {
+        return -1;
+    }
+    result->samples[0][run] = (get_monotonic_ns() - start) / NS_PER_MS;
+    for (int stage = 1; stage < STAGE_COUNT; stage++) {
+        result->samples[stage][run] = get_stats_value(stats,
+                stageNames[stage]);
+    }
+    result->matches = (long) get_stats_value(stats, "matches");
+    return 0;
+}
+
+/* static double get_stats_value(const char *stats, const char *name)
+* -----------------------------------------------
+* Looks up a number in the JSON statistics printed by -stats json
+*
+* stats: the statistics
+* name: key of the number
+*
+* Returns: the number, or 0 if it is missing
+* Errors: -
+*/
+static double get_stats_value(const char *stats, const char *name)
+{
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\": ", name);
+    const char *found = strstr(stats, key);
+    return found ? atof(found + strlen(key)) : 0;
+}
+
+/* static int compare_doubles(const void *a, const void *b)
+* -----------------------------------------------
+* qsort() comparator for doubles in ascending order
+*
+* a, b: the doubles
+*
+* Returns: negative, zero or positive as for strcmp()
+* Errors: -
+*/
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* static double get_percentile(double *samples, int count,
+*        double percentile)
+* -----------------------------------------------
+* Nearest rank percentile of sorted samples
+*
+* samples: the samples, in ascending order
+* count: number of samples
+* percentile: the percentile, 0 to 100
+*
+* Returns: the percentile
+* Errors: -
+*/
+static double get_percentile(double *samples, int count, double percentile)
+{
+    int rank = (int) (percentile / 100 * count + 0.999999);
+    return samples[rank < 1 ? 0 : rank - 1];
+}
+
+/* static void write_query_result(FILE *out, const char *query,
+*        QueryResult *result, int runs)
+* -----------------------------------------------
+* Writes the percentiles of every stage of a query as one JSON object
+*
+* out: the results file
+* query: the query
+* result: the query's samples, sorted in place
+* runs: number of runs
+*
+* Returns: -
+* Errors: -
+*/
+static void write_query_result(FILE *out, const char *query,
+        QueryResult *result, int runs)
+{
+    fprintf(out, "{\"query\": ");
+    write_json_string(out, query);
+    fprintf(out, ", \"matches\": %ld", result->matches);
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        qsort(result->samples[stage], runs, sizeof(double), compare_doubles);
+        fprintf(out, ", \"%s_ms\": {", stageNames[stage]);
+        for (int i = 0; i < PERCENTILE_COUNT; i++) {
+            fprintf(out, "%s\"p%.0f\": %.3f", i ? ", " : "", percentiles[i],
+                    get_percentile(result->samples[stage], runs,
+                    percentiles[i]));
+        }
+        fprintf(out, "}");
+    }
+    fprintf(out, "}\n");
+}
+
+/* static void write_json_string(FILE *out, const char *s)
+* -----------------------------------------------
+* Writes a string as a quoted JSON string
+*
+* out: where the string is written
+* s: the string
+*
+* Returns: -
+* Errors: -
+*/
+static void write_json_string(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+/* static int compare_with_baseline(const char *resultsPath,
+*        const char *baselinePath, double tolerance)
+* -----------------------------------------------
+* Compares the median in-process time of every query with the baseline and
+* prints the change. Queries missing from the baseline are skipped.
+*
+* resultsPath: the results just written
+* baselinePath: the stored baseline
+* tolerance: largest slowdown accepted, in percent
+*
+* Returns: the number of queries that got slower than the tolerance allows
+* Errors: -
+*/
+static int compare_with_baseline(const char *resultsPath,
+        const char *baselinePath, double tolerance)
+{
+    FILE *results = fopen(resultsPath, "r");
+    FILE *baseline = fopen(baselinePath, "r");
+    if (results == 0 || baseline == 0) {
+        fprintf(stderr, "harness: no baseline to compare with\n");
+        if (results) {
+            fclose(results);
+        }
+        return 0;
+    }
+    char line[MAX_STATS_SIZE], base[MAX_STATS_SIZE];
+    char query[MAX_QUERY_SIZE], baseQuery[MAX_QUERY_SIZE];
+    double p50, baseP50;
+    int regressions = 0;
+    printf("%-50s %10s %10s %8s\n", "query", "baseline", "now", "change");
+    while (fgets(line, sizeof(line), results)) {
+        if (!find_query_p50(line, "total", query, sizeof(query), &p50)) {
+            continue;
+        }
+        rewind(baseline);
+        while (fgets(base, sizeof(base), baseline)) {
+            if (!find_query_p50(base, "total", baseQuery, sizeof(baseQuery),
+                    &baseP50) || strcmp(query, baseQuery) != 0) {
+                continue;
+            }
+            double change = baseP50 > 0 ? (p50 - baseP50) / baseP50 * 100 : 0;
+            int regressed = change > tolerance;
+            regressions += regressed;
+            printf("%-50s %8.3fms %8.3fms %+7.1f%%%s\n", query, baseP50, p50,
+                    change, regressed ? " REGRESSED" : "");
+            break;
+        }
+    }
+    fclose(results);
+    fclose(baseline);
+    return regressions;
+}
+
+/* static int find_query_p50(const char *line, const char *stage,
+*        char *query, size_t size, double *p50)
+* -----------------------------------------------
+* Reads the query and the median time of a stage from a line of results
+*
+* line: the line
+* stage: name of the stage
+* query: receives the query (JSON escapes are kept as they are)
+* size: size of query
+* p50: receives the median
+*
+* Returns: 1 if the line holds a query result, 0 otherwise
+* Errors: -
+*/
+static int find_query_p50(const char *line, const char *stage,
+        char *query, size_t size, double *p50)
+{
+    const char *start = strstr(line, "{\"query\": \"");
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s_ms\": {\"p50\": ", stage);
+    const char *found = strstr(line, key);
+    if (start == 0 || found == 0) {
+        return 0;
+    }
+    start += strlen("{\"query\": \"");
+    const char *end = strstr(start, "\", \"matches\"");
+    if (end == 0 || (size_t) (end - start) >= size) {
+        return 0;
+    }
+    memcpy(query, start, end - start);
+    query[end - start] = '\0';
+    *p50 = atof(found + strlen(key));
+    return 1;
+}
@@ -0,0 +1,128 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <string.h>
+#include "bitsetindex.h"
+
+// A bucket of words of length len has len * ALPHABET_SIZE positional bitsets
+// (bit i of set [pos][letter] is set if word i has letter at pos), followed
+// by ALPHABET_SIZE "contains" bitsets (bit i set if word i has the letter
+// anywhere). Each bitset is get_bitset_words(count) 64-bit words long.
+
+/* size_t get_bitset_words(uint32_t count)
+* -----------------------------------------------
+* Number of 64-bit words in a bitset over count words
+*
+* count: number of words in the bucket
+*
+* Returns: bitset length in 64-bit words
+* Errors: -
+*/
+size_t get_bitset_words(uint32_t count)
+{
+    return ((size_t) count + 63) / 64;
+}
+
+/* size_t get_position_bitsets_size(int len, uint32_t count)
+* -----------------------------------------------
+* Size in bytes of all positional and contains bitsets of a bucket
+*
+* len: word length of the bucket
+* count: number of words in the bucket
+*
+* Returns: the size in bytes
+* Errors: -
+*/
+size_t get_position_bitsets_size(int len, uint32_t count)
+{
+    return (size_t) (len + 1) * ALPHABET_SIZE * get_bitset_words(count)
+            * sizeof(uint64_t);
+}
+
+/* void build_position_bitsets(const WordBucket *bucket, uint64_t *bitsets)
+* -----------------------------------------------
+* Builds the inverted positional index of a bucket
+*
+* bucket: bucket whose words are indexed
+* bitsets: get_position_bitsets_size() bytes that receive the bitsets
+*
+* Returns: -
+* Errors: -
+*/
+void build_position_bitsets(const WordBucket *bucket, uint64_t *bitsets)
+{
+    int len = bucket->len;
+    size_t setWords = get_bitset_words(bucket->count);
+    uint64_t *contains = bitsets + (size_t) len * ALPHABET_SIZE * setWords;
+    memset(bitsets, 0, get_position_bitsets_size(len, bucket->count));
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        const char *word = bucket->words + (size_t) i * (len + 1);
+        uint64_t bit = 1ull << (i % 64);
+        size_t block = i / 64;
+        for (int pos = 0; pos < len; pos++) {
+            int letter = word[pos] - 'A';
+            bitsets[((size_t) pos * ALPHABET_SIZE + letter) * setWords
+                    + block] |= bit;
+            contains[(size_t) letter * setWords + block] |= bit;
+        }
+    }
+}
+
+/* void match_position_bitsets(const WordBucket *bucket,
+*        const PredicatePlan *plan, uint32_t first, uint32_t end,
+*        uint64_t *result)
+* -----------------------------------------------
+* Finds the words that have the pattern's letters at the pattern's positions,
+* none of the letters feedback rules out at a position, every -with letter
+* and none of the -without letters, by ANDing the relevant bitsets (or their
+* complements) together in the plan's order. A block of 64 words is done
+* as soon as none of them is left. Letter counts are not checked here;
+* survivors still need matches_letter_requirements() when -with has
+* repeated letters or feedback bounds the counts.
+*
+* bucket: bucket with positional bitsets
+* plan: the tests of the query, in the order they are run
+* first: first word to match, a multiple of 64
+* end: one past the last word to match
+* result: receives one bit per word from first to end-1 (bit 0 of result[0]
+*         is word first)
+*
+* Returns: -
+* Errors: -
+*/
+void match_position_bitsets(const WordBucket *bucket,
+        const PredicatePlan *plan, uint32_t first, uint32_t end,
+        uint64_t *result)
+{
+    const uint64_t *sets[MAX_PREDICATES];
+    // All ones for the tests a word passes by not being in the set
+    uint64_t flips[MAX_PREDICATES];
+    int len = bucket->len;
+    size_t setWords = get_bitset_words(bucket->count);
+    const uint64_t *contains = bucket->bitsets
+            + (size_t) len * ALPHABET_SIZE * setWords;
+    for (int p = 0; p < plan->count; p++) {
+        const Predicate *predicate = &plan->predicates[p];
+        if (predicate->kind == PREDICATE_FIXED
+                || predicate->kind == PREDICATE_EXCLUDED) {
+            sets[p] = bucket->bitsets + ((size_t) predicate->pos
+                    * ALPHABET_SIZE + predicate->letter) * setWords;
+        } else {
+            sets[p] = contains + (size_t) predicate->letter * setWords;
+        }
+        flips[p] = predicate->kind == PREDICATE_EXCLUDED
+                || predicate->kind == PREDICATE_WITHOUT ? ~0ull : 0;
+    }
+    size_t endBlock = get_bitset_words(end);
+    for (size_t block = first / 64; block < endBlock; block++) {
+        uint64_t bits = ~0ull;
+        for (int p = 0; p < plan->count && bits; p++) {
+            bits &= sets[p][block] ^ flips[p];
+        }
+        result[block - first / 64] = bits;
+    }
+    // Clear the bits past the last word
+    if (end % 64) {
+        result[endBlock - 1 - first / 64] &= (1ull << (end % 64)) - 1;
+    }
+}
@@ -0,0 +1,23 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef BITSETINDEX_H
+#define BITSETINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lettermask.h"
+#include "wordindex.h"
+#include "predicate.h"
+
+/*
+* Function Prototypes
+*/
+size_t get_bitset_words(uint32_t count);
+size_t get_position_bitsets_size(int len, uint32_t count);
+void build_position_bitsets(const WordBucket *bucket, uint64_t *bitsets);
+void match_position_bitsets(const WordBucket *bucket,
+        const PredicatePlan *plan, uint32_t first, uint32_t end,
+        uint64_t *result);
+
+#endif
@@ -0,0 +1,229 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dictionary.h"
+
+#define READ_CHUNK_SIZE 65536
+
+/*
+* Function Prototypes
+*/
+static int read_whole_file(int fd, Dictionary *dictionary);
+
+/* const char *get_dictionary_path(void)
+* -----------------------------------------------
+* If the WORDLE_DICTIONARY environment variable is set, the dictionary file is
+* loaded from there, else defaults to "/usr/share/dict/words"
+*
+* Returns: the path of the dictionary file
+* Errors: -
+*/
+const char *get_dictionary_path(void)
+{
+    const char *path = getenv("WORDLE_DICTIONARY");
+    if (path == 0) {
+        path = DEFAULT_DICTIONARY;
+    }
+    return path;
+}
+
+/* void report_dictionary_error(const char *path)
+* -----------------------------------------------
+* Prints the error message for a dictionary that cannot be opened and exits
+*
+* path: path of the dictionary file
+*
+* Returns: -
+* Errors: exits with code 3
+*/
+void report_dictionary_error(const char *path)
+{
+    fprintf(stderr,
+            "wordle-helper: dictionary file \"%s\" cannot be opened\n",
+            path);
+    exit(3);
+}
+
+/* Dictionary *open_dictionary(void)
+* -----------------------------------------------
+* Checks for the existence of the dictionary file and loads it.
+*
+* Returns: the loaded dictionary
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+Dictionary *open_dictionary(void)
+{
+    const char *path = get_dictionary_path();
+    Dictionary *dictionary = load_dictionary(path);
+    if (dictionary == 0) {
+        report_dictionary_error(path);
+    }
+    return dictionary;
+}
+
+/* Dictionary *load_dictionary(const char *path)
+* -----------------------------------------------
+* Loads the whole dictionary file into memory. Regular files are mapped with
+* mmap(); pipes, character devices and files that cannot be mapped are read
+* with read() into a heap buffer instead.
+*
+* path: path of the dictionary file
+*
+* Returns: the loaded dictionary, or NULL if the file cannot be opened or read
+* Errors: -
+*/
+Dictionary *load_dictionary(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    Dictionary *dictionary = calloc(1, sizeof(Dictionary));
+    dictionary->path = path;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            dictionary->data = data;
+            dictionary->size = st.st_size;
+            dictionary->mapped = 1;
+        }
+    }
+    if (!dictionary->mapped && read_whole_file(fd, dictionary) != 0) {
+        close(fd);
+        free(dictionary->data);
+        free(dictionary);
+        return 0;
+    }
+    close(fd);
+    return dictionary;
+}
+
+/* static int read_whole_file(int fd, Dictionary *dictionary)
+* -----------------------------------------------
+* Reads everything from fd into a growing heap buffer. Used for dictionaries
+* that are not regular files (e.g. pipes) or that could not be mapped.
+*
+* fd: file descriptor to read from
+* dictionary: dictionary whose data and size are filled in
+*
+* Returns: 0 on success, -1 if a read error occurred
+* Errors: -
+*/
+static int read_whole_file(int fd, Dictionary *dictionary)
+{
+    size_t capacity = READ_CHUNK_SIZE;
+    size_t size = 0;
+    char *data = malloc(capacity);
+    while (1) {
+        if (size == capacity) {
+            capacity = capacity * 2;
+            data = realloc(data, capacity);
+        }
+        ssize_t got = read(fd, data + size, capacity - size);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            dictionary->data = data;
+            return -1;
+        }
+        if (got == 0) {
+            break;
+        }
+        size += got;
+    }
+    dictionary->data = data;
+    dictionary->size = size;
+    return 0;
+}
+
+/* const char *next_dictionary_word(const Dictionary *dictionary,
+*        size_t *offset, int *wordLen)
+* -----------------------------------------------
+* Finds the next whitespace separated word in the dictionary, starting at
+* *offset. The word is not copied or NUL terminated; the caller gets a pointer
+* into the loaded data along with its length, so that words of the wrong
+* length can be rejected without touching their characters.
+*
+* dictionary: the loaded dictionary
+* offset: position to start scanning from, advanced past the returned word
+* wordLen: set to the length of the returned word
+*
+* Returns: a pointer to the start of the word, or NULL at end of dictionary
+* Errors: -
+*/
+const char *next_dictionary_word(const Dictionary *dictionary,
+        size_t *offset, int *wordLen)
+{
+    const char *data = dictionary->data;
+    size_t size = dictionary->size;
+    size_t i = *offset;
+    while (i < size && isspace((unsigned char) data[i])) {
+        i++;
+    }
+    if (i == size) {
+        *offset = size;
+        return 0;
+    }
+    size_t start = i;
+    while (i < size && !isspace((unsigned char) data[i])) {
+        i++;
+    }
+    *offset = i;
+    *wordLen = (i - start) > (size_t) 0x7fffffff ? 0x7fffffff : (i - start);
+    return data + start;
+}
+
+/* void close_dictionary(Dictionary *dictionary)
+* -----------------------------------------------
+* Releases the memory (or mapping) that holds the dictionary
+*
+* dictionary: the dictionary to be closed
+*
+* Returns: -
+* Errors: -
+*/
+void close_dictionary(Dictionary *dictionary)
+{
+    if (dictionary->mapped) {
+        munmap(dictionary->data, dictionary->size);
+    } else {
+        free(dictionary->data);
+    }
+    free(dictionary);
+}
+
+/* void convert_word_to_uppercase(char dictionaryString[], int *foundSpecial)
+* -----------------------------------------------
+* Checks if the word scanned from the dictionary contains any 
+* special characters and converts the word to uppercase if no special
+* characters are found
+*
+* dictionaryString: dictionary string that needs to be converted
+* foundSpecial: flag to indicate that a special character is found
+*
+* Returns: -
+* Errors: -
+*/
+void convert_word_to_uppercase(char dictionaryString[], int *foundSpecial) {
+    for (int i = 0; dictionaryString[i]; i++) {
+        if (isalpha(dictionaryString[i])) {
+            *foundSpecial = 0;
+            dictionaryString[i] = toupper(dictionaryString[i]);
+        } else {
+            *foundSpecial = 1;
+            break;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <stddef.h>
+
+#define DEFAULT_DICTIONARY "/usr/share/dict/words"
+
+/*
+* Struct Definition
+*/
+typedef struct {
+    const char *path;
+    char *data;
+    size_t size;
+    int mapped;
+} Dictionary;
+
+/*
+* Function Prototypes
+*/
+const char *get_dictionary_path(void);
+void report_dictionary_error(const char *path);
+Dictionary *open_dictionary(void);
+Dictionary *load_dictionary(const char *path);
+const char *next_dictionary_word(const Dictionary *dictionary,
+        size_t *offset, int *wordLen);
+void close_dictionary(Dictionary *dictionary);
+void convert_word_to_uppercase(char dictionaryString[], int *foundSpecial);
+
+#endif
@@ -0,0 +1,769 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "entropy.h"
+#include "dictionary.h"
+#include "bitsetindex.h"
+#include "parallel.h"
+#include "wordsort.h"
+
+// A guess is ranked by the information it is expected to give: the entropy
+// of the distribution of feedback it would get over the remaining
+// candidates. The feedback of a guess against an answer is encoded as a
+// base 3 number with one digit per position (0 black, 1 yellow, 2 green,
+// position 0 least significant), so it fits in a byte up to length 5 and
+// in two bytes up to MAX_LEN.
+//
+// The codes of every guess against every answer of a bucket can be kept in
+// a matrix in the cache directory, built the first time -entropy runs on
+// that dictionary and length. The matrix holds count * count codes, so it
+// is only built when it stays under WORDLE_MATRIX_MAX_MB megabytes
+// (DEFAULT_MATRIX_MAX_MB by default, 0 turns it off); otherwise the codes
+// are computed as they are needed.
+
+#define MATRIX_MAGIC "WRDLFBM"
+#define MATRIX_VERSION 1
+#define DEFAULT_MATRIX_MAX_MB 256
+// Guesses a thread takes from the shared queue at a time
+#define GUESS_BATCH 64
+
+/*
+* Struct Definitions
+*/
+// On-disk header of a cached feedback matrix; row g of the codes that
+// follow holds the codes of guess g against every word of the bucket
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t len;
+    uint32_t count;
+    uint32_t codeBytes;
+    uint64_t wordsHash;
+} MatrixHeader;
+
+// What write_matrix_file() writes
+typedef struct {
+    const MatrixHeader *header;
+    const void *codes;
+    size_t size;
+} MatrixFile;
+
+typedef struct {
+    const void *codes;
+    int codeBytes;
+    void *mapping;
+    size_t mappingSize;
+    void *built;
+} FeedbackMatrix;
+
+// Entropy of guess guessIds[i] (or word i if guessIds is NULL) over the
+// answers, stored in entropies[i]
+typedef struct {
+    const WordBucket *bucket;
+    const FeedbackMatrix *matrix;
+    const uint32_t *guessIds;
+    uint32_t guessCount;
+    const uint32_t *answers;
+    int answerCount;
+    int codeCount;
+    // plogp[c] is c * log2(c)
+    const double *plogp;
+    double *entropies;
+    // Next guess to be taken by a thread
+    uint32_t next;
+} EntropyContext;
+
+// Combined value of word i as a guess for several boards at once, stored
+// in values[i]. answers is the union of the boards' candidates and
+// boardMasks[j] the boards answers[j] is a candidate on; boardsOf[i] is the
+// same for every word of the bucket.
+typedef struct {
+    const WordBucket *bucket;
+    const FeedbackMatrix *matrix;
+    const uint32_t *answers;
+    const uint32_t *boardMasks;
+    int answerCount;
+    const uint32_t *boardsOf;
+    const int *boardSizes;
+    int boardCount;
+    int codeCount;
+    const double *plogp;
+    double *values;
+    uint32_t next;
+} BoardContext;
+
+typedef struct {
+    const WordBucket *bucket;
+    void *codes;
+    int codeBytes;
+    int chunkCount;
+} MatrixBuild;
+
+typedef struct {
+    const WordBucket *bucket;
+    const double *entropies;
+    const uint64_t *isAnswer;
+} GuessOrder;
+
+/*
+* Function Prototypes
+*/
+static int get_code_count(int len);
+static void compute_entropies(EntropyContext *context, int threads);
+static void rank_guess_batches(int chunk, void *context);
+static void rank_board_batches(int chunk, void *context);
+static int order_guesses(const WordBucket *bucket, const double *values,
+        const uint32_t *answerIds, int answerCount, int limit,
+        CandidateList *guesses);
+static int compare_guesses(const void *id1, const void *id2, void *context);
+static int open_feedback_matrix(const WordBucket *bucket, int threads,
+        FeedbackMatrix *matrix);
+static int load_feedback_matrix(const char *path, const MatrixHeader *header,
+        FeedbackMatrix *matrix);
+static void build_matrix_rows(int chunk, void *context);
+static int write_matrix_file(FILE *file, const void *context);
+static void close_feedback_matrix(FeedbackMatrix *matrix);
+
+/* uint32_t get_feedback_code(const char *guess, const char *answer, int len)
+* -----------------------------------------------
+* Works out the feedback a guess gets against an answer, the way the game
+* marks it: greens first, then yellows from left to right for as many
+* copies of a letter as the answer has left over
+*
+* guess: the guessed word
+* answer: the answer
+* len: length of both words
+*
+* Returns: the feedback code (see above)
+* Errors: -
+*/
+uint32_t get_feedback_code(const char *guess, const char *answer, int len)
+{
+    uint8_t left[ALPHABET_SIZE];
+    uint32_t greens = 0;
+    memset(left, 0, sizeof(left));
+    for (int pos = 0; pos < len; pos++) {
+        if (guess[pos] == answer[pos]) {
+            greens |= 1u << pos;
+        } else {
+            left[answer[pos] - 'A']++;
+        }
+    }
+    uint32_t code = 0;
+    uint32_t weight = 1;
+    for (int pos = 0; pos < len; pos++, weight *= 3) {
+        if (greens & (1u << pos)) {
+            code += 2 * weight;
+        } else if (left[guess[pos] - 'A']) {
+            left[guess[pos] - 'A']--;
+            code += weight;
+        }
+    }
+    return code;
+}
+
+/* int rank_guesses_by_entropy(const WordBucket *bucket,
+*        const CandidateList *answers, int threads, int limit,
+*        CandidateList *guesses)
+* -----------------------------------------------
+* Ranks every word of the bucket as a guess by the entropy of its feedback
+* over the remaining answers. Threads take guesses off a shared queue in
+* small batches, so threads that get cheap guesses (or a faster core) do
+* more of them. Ties go to guesses that could be the answer, then to
+* alphabetical order.
+*
+* bucket: the words that may be guessed
+* answers: the words that may still be the answer
+* threads: maximum number of threads to use
+* limit: if non-zero, only the best limit guesses are kept
+* guesses: receives the ranked guesses; release with free_candidates()
+*
+* Returns: the number of guesses ranked, 0 if there are no answers
+* Errors: -
+*/
+int rank_guesses_by_entropy(const WordBucket *bucket,
+        const CandidateList *answers, int threads, int limit,
+        CandidateList *guesses)
+{
+    guesses->bucket = bucket;
+    guesses->count = 0;
+    init_arena(&guesses->arena);
+    if (answers->count == 0) {
+        return 0;
+    }
+    Arena *arena = &guesses->arena;
+    FeedbackMatrix matrix;
+    EntropyContext context;
+    context.bucket = bucket;
+    context.matrix = open_feedback_matrix(bucket, threads, &matrix)
+            ? &matrix : 0;
+    context.guessIds = 0;
+    context.guessCount = bucket->count;
+    context.answers = answers->ids;
+    context.answerCount = answers->count;
+    context.entropies = arena_alloc(arena, bucket->count * sizeof(double));
+    compute_entropies(&context, threads);
+    if (context.matrix) {
+        close_feedback_matrix(&matrix);
+    }
+    return order_guesses(bucket, context.entropies, answers->ids,
+            answers->count, limit, guesses);
+}
+
+/* int rank_guesses_across_boards(const WordBucket *bucket,
+*        const CandidateList *boards, int boardCount, int threads,
+*        int limit, CandidateList *guesses)
+* -----------------------------------------------
+* Ranks every word of a bucket as a guess for several boards played at
+* once, each with its own candidates. A guess is worth the sum of the
+* entropies of its feedback on each board, plus the chance that it is the
+* answer of each board it could solve, so that a board down to one word
+* gets solved rather than left for last. Ties are broken as by
+* rank_guesses_by_entropy(), with a candidate of any board counting as a
+* candidate. The feedback of a guess is worked out once for each word of
+* the union of the candidates and counted towards every board the word is
+* a candidate on.
+*
+* bucket: the bucket holding the words
+* boards: the candidates of each board, in bucket order
+* boardCount: number of boards (at most 32)
+* threads: maximum number of threads to use
+* limit: if non-zero, only the best limit guesses are kept
+* guesses: receives the ranked guesses; release with free_candidates()
+*
+* Returns: the number of guesses ranked, 0 if a board has no candidates
+* Errors: -
+*/
+int rank_guesses_across_boards(const WordBucket *bucket,
+        const CandidateList *boards, int boardCount, int threads,
+        int limit, CandidateList *guesses)
+{
+    guesses->bucket = bucket;
+    guesses->count = 0;
+    init_arena(&guesses->arena);
+    Arena *arena = &guesses->arena;
+    uint32_t *boardsOf = arena_alloc(arena, bucket->count * sizeof(uint32_t));
+    int *boardSizes = arena_alloc(arena, boardCount * sizeof(int));
+    memset(boardsOf, 0, bucket->count * sizeof(uint32_t));
+    int maxSize = 0;
+    for (int board = 0; board < boardCount; board++) {
+        if (boards[board].count == 0) {
+            return 0;
+        }
+        boardSizes[board] = boards[board].count;
+        maxSize = boards[board].count > maxSize ? boards[board].count
+                : maxSize;
+        for (int i = 0; i < boards[board].count; i++) {
+            boardsOf[boards[board].ids[i]] |= 1u << board;
+        }
+    }
+    // The union, in bucket order
+    int answerCount = 0;
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        answerCount += boardsOf[i] != 0;
+    }
+    uint32_t *answers = arena_alloc(arena, answerCount * sizeof(uint32_t));
+    uint32_t *boardMasks = arena_alloc(arena,
+            answerCount * sizeof(uint32_t));
+    for (uint32_t i = 0, j = 0; i < bucket->count; i++) {
+        if (boardsOf[i]) {
+            answers[j] = i;
+            boardMasks[j++] = boardsOf[i];
+        }
+    }
+    double *plogp = arena_alloc(arena, (maxSize + 1) * sizeof(double));
+    plogp[0] = 0;
+    for (int c = 1; c <= maxSize; c++) {
+        plogp[c] = c * log2(c);
+    }
+    FeedbackMatrix matrix;
+    BoardContext context;
+    context.bucket = bucket;
+    context.matrix = open_feedback_matrix(bucket, threads, &matrix)
+            ? &matrix : 0;
+    context.answers = answers;
+    context.boardMasks = boardMasks;
+    context.answerCount = answerCount;
+    context.boardsOf = boardsOf;
+    context.boardSizes = boardSizes;
+    context.boardCount = boardCount;
+    context.codeCount = get_code_count(bucket->len);
+    context.plogp = plogp;
+    context.values = arena_alloc(arena, bucket->count * sizeof(double));
+    context.next = 0;
+    int chunkCount = (bucket->count + GUESS_BATCH - 1) / GUESS_BATCH;
+    run_parallel(chunkCount < threads ? chunkCount : threads,
+            rank_board_batches, &context);
+    if (context.matrix) {
+        close_feedback_matrix(&matrix);
+    }
+    return order_guesses(bucket, context.values, answers, answerCount, limit,
+            guesses);
+}
+
+/* void score_guess_entropies(const WordBucket *bucket,
+*        const uint32_t *guessIds, int guessCount, const uint32_t *answerIds,
+*        int answerCount, int threads, double *entropies)
+* -----------------------------------------------
+* Works out the entropy of the feedback of some guesses over some answers,
+* computing the feedback codes as it goes
+*
+* bucket: the bucket holding the words
+* guessIds: IDs of the guesses
+* guessCount: number of guesses
+* answerIds: IDs of the answers
+* answerCount: number of answers (greater than 0)
+* threads: maximum number of threads to use
+* entropies: receives the entropy of guess guessIds[i] in entropies[i]
+*
+* Returns: -
+* Errors: -
+*/
+void score_guess_entropies(const WordBucket *bucket,
+        const uint32_t *guessIds, int guessCount, const uint32_t *answerIds,
+        int answerCount, int threads, double *entropies)
+{
+    EntropyContext context;
+    context.bucket = bucket;
+    context.matrix = 0;
+    context.guessIds = guessIds;
+    context.guessCount = guessCount;
+    context.answers = answerIds;
+    context.answerCount = answerCount;
+    context.entropies = entropies;
+    compute_entropies(&context, threads);
+}
+
+/* static int get_code_count(int len)
+* -----------------------------------------------
+* Number of distinct feedback codes for words of a given length
+*
+* len: word length
+*
+* Returns: 3 to the power len
+* Errors: -
+*/
+static int get_code_count(int len)
+{
+    int count = 1;
+    for (int pos = 0; pos < len; pos++) {
+        count *= 3;
+    }
+    return count;
+}
+
+/* static void compute_entropies(EntropyContext *context, int threads)
+* -----------------------------------------------
+* Fills in the entropies of a context whose guesses and answers are set
+*
+* context: the context
+* threads: maximum number of threads to use
+*
+* Returns: -
+* Errors: -
+*/
+static void compute_entropies(EntropyContext *context, int threads)
+{
+    double *plogp = malloc((context->answerCount + 1) * sizeof(double));
+    plogp[0] = 0;
+    for (int c = 1; c <= context->answerCount; c++) {
+        plogp[c] = c * log2(c);
+    }
+    context->plogp = plogp;
+    context->codeCount = get_code_count(context->bucket->len);
+    context->next = 0;
+    int chunkCount = (context->guessCount + GUESS_BATCH - 1) / GUESS_BATCH;
+    run_parallel(chunkCount < threads ? chunkCount : threads,
+            rank_guess_batches, context);
+    free(plogp);
+}
+
+/* static void rank_guess_batches(int chunk, void *context)
+* -----------------------------------------------
+* Thread body of compute_entropies(): works out the entropy of batches of
+* guesses until none are left
+*
+* chunk: index of the thread
+* context: the EntropyContext
+*
+* Returns: -
+* Errors: -
+*/
+static void rank_guess_batches(int chunk, void *context)
+{
+    EntropyContext *entropy = context;
+    const WordBucket *bucket = entropy->bucket;
+    const FeedbackMatrix *matrix = entropy->matrix;
+    int stride = bucket->len + 1;
+    int answerCount = entropy->answerCount;
+    uint32_t *histogram = calloc(entropy->codeCount, sizeof(uint32_t));
+    uint32_t *seen = malloc(entropy->codeCount * sizeof(uint32_t));
+    double total = log2(answerCount);
+    (void) chunk;
+    while (1) {
+        uint32_t first = __atomic_fetch_add(&entropy->next, GUESS_BATCH,
+                __ATOMIC_RELAXED);
+        if (first >= entropy->guessCount) {
+            break;
+        }
+        uint32_t end = entropy->guessCount - first > GUESS_BATCH
+                ? first + GUESS_BATCH : entropy->guessCount;
+        for (uint32_t i = first; i < end; i++) {
+            uint32_t guess = entropy->guessIds ? entropy->guessIds[i] : i;
+            const char *word = bucket->words + (size_t) guess * stride;
+            const uint8_t *row8 = 0;
+            const uint16_t *row16 = 0;
+            if (matrix && matrix->codeBytes == 1) {
+                row8 = (const uint8_t *) matrix->codes
+                        + (size_t) guess * bucket->count;
+            } else if (matrix) {
+                row16 = (const uint16_t *) matrix->codes
+                        + (size_t) guess * bucket->count;
+            }
+            int seenCount = 0;
+            for (int i = 0; i < answerCount; i++) {
+                uint32_t answer = entropy->answers[i];
+                uint32_t code = row8 ? row8[answer] : row16 ? row16[answer]
+                        : get_feedback_code(word, bucket->words
+                        + (size_t) answer * stride, bucket->len);
+                if (histogram[code]++ == 0) {
+                    seen[seenCount++] = code;
+                }
+            }
+            double sum = 0;
+            for (int i = 0; i < seenCount; i++) {
+                sum += entropy->plogp[histogram[seen[i]]];
+                histogram[seen[i]] = 0;
+            }
+            entropy->entropies[i] = total - sum / answerCount;
+        }
+    }
+    free(seen);
+    free(histogram);
+}
+
+/* static void rank_board_batches(int chunk, void *context)
+* -----------------------------------------------
+* Thread body of rank_guesses_across_boards(): works out the value of
+* batches of guesses until none are left. The feedback counts of every
+* board share one histogram, board b's codes from b * codeCount on.
+*
+* chunk: index of the thread
+* context: the BoardContext
+*
+* Returns: -
+* Errors: -
+*/
+static void rank_board_batches(int chunk, void *context)
+{
+    BoardContext *boards = context;
+    const WordBucket *bucket = boards->bucket;
+    const FeedbackMatrix *matrix = boards->matrix;
+    int stride = bucket->len + 1;
+    int codeCount = boards->codeCount;
+    uint32_t *histogram = calloc((size_t) boards->boardCount * codeCount,
+            sizeof(uint32_t));
+    size_t seenSize = 0;
+    double total = 0;
+    for (int board = 0; board < boards->boardCount; board++) {
+        seenSize += boards->boardSizes[board];
+        total += log2(boards->boardSizes[board]);
+    }
+    uint32_t *seen = malloc(seenSize * sizeof(uint32_t));
+    (void) chunk;
+    while (1) {
+        uint32_t first = __atomic_fetch_add(&boards->next, GUESS_BATCH,
+                __ATOMIC_RELAXED);
+        if (first >= bucket->count) {
+            break;
+        }
+        uint32_t end = bucket->count - first > GUESS_BATCH
+                ? first + GUESS_BATCH : bucket->count;
+        for (uint32_t guess = first; guess < end; guess++) {
+            const char *word = bucket->words + (size_t) guess * stride;
+            const uint8_t *row8 = 0;
+            const uint16_t *row16 = 0;
+            if (matrix && matrix->codeBytes == 1) {
+                row8 = (const uint8_t *) matrix->codes
+                        + (size_t) guess * bucket->count;
+            } else if (matrix) {
+                row16 = (const uint16_t *) matrix->codes
+                        + (size_t) guess * bucket->count;
+            }
+            int seenCount = 0;
+            for (int i = 0; i < boards->answerCount; i++) {
+                uint32_t answer = boards->answers[i];
+                uint32_t code = row8 ? row8[answer] : row16 ? row16[answer]
+                        : get_feedback_code(word, bucket->words
+                        + (size_t) answer * stride, bucket->len);
+                for (uint32_t mask = boards->boardMasks[i]; mask;
+                        mask &= mask - 1) {
+                    uint32_t slot = __builtin_ctz(mask) * codeCount + code;
+                    if (histogram[slot]++ == 0) {
+                        seen[seenCount++] = slot;
+                    }
+                }
+            }
+            double value = total;
+            for (int i = 0; i < seenCount; i++) {
+                value -= boards->plogp[histogram[seen[i]]]
+                        / boards->boardSizes[seen[i] / codeCount];
+                histogram[seen[i]] = 0;
+            }
+            for (uint32_t mask = boards->boardsOf[guess]; mask;
+                    mask &= mask - 1) {
+                value += 1.0 / boards->boardSizes[__builtin_ctz(mask)];
+            }
+            boards->values[guess] = value;
+        }
+    }
+    free(seen);
+    free(histogram);
+}
+
+/* static int order_guesses(const WordBucket *bucket, const double *values,
+*        const uint32_t *answerIds, int answerCount, int limit,
+*        CandidateList *guesses)
+* -----------------------------------------------
+* Puts every word of a bucket in rank order as a guess: highest value
+* first, then candidates before other words, then alphabetically
+*
+* bucket: the bucket holding the words
+* values: the value of each word as a guess
+* answerIds: IDs of the candidates
+* answerCount: number of candidates
+* limit: if non-zero, only the best limit guesses are kept
+* guesses: the list being built, whose arena the order is allocated from
+*
+* Returns: the number of guesses ranked
+* Errors: -
+*/
+static int order_guesses(const WordBucket *bucket, const double *values,
+        const uint32_t *answerIds, int answerCount, int limit,
+        CandidateList *guesses)
+{
+    Arena *arena = &guesses->arena;
+    size_t blocks = get_bitset_words(bucket->count);
+    uint64_t *isAnswer = arena_alloc(arena, blocks * sizeof(uint64_t));
+    memset(isAnswer, 0, blocks * sizeof(uint64_t));
+    for (int i = 0; i < answerCount; i++) {
+        isAnswer[answerIds[i] / 64] |= 1ull << (answerIds[i] % 64);
+    }
+    guesses->ids = arena_alloc(arena, bucket->count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        guesses->ids[i] = i;
+    }
+    GuessOrder order = {bucket, values, isAnswer};
+    qsort_r(guesses->ids, bucket->count, sizeof(uint32_t), compare_guesses,
+            &order);
+    guesses->count = limit && (uint32_t) limit < bucket->count ? limit
+            : (int) bucket->count;
+    return guesses->count;
+}
+
+/* static int compare_guesses(const void *id1, const void *id2,
+*        void *context)
+* -----------------------------------------------
+* qsort_r() comparator putting guesses in rank order
+*
+* id1, id2: the word IDs of the guesses
+* context: the GuessOrder
+*
+* Returns: negative, zero or positive as for strcmp()
+* Errors: -
+*/
+static int compare_guesses(const void *id1, const void *id2, void *context)
+{
+    const GuessOrder *order = context;
+    uint32_t a = *(const uint32_t *) id1;
+    uint32_t b = *(const uint32_t *) id2;
+    double ea = order->entropies[a], eb = order->entropies[b];
+    if (ea != eb) {
+        return ea > eb ? -1 : 1;
+    }
+    int answerA = (order->isAnswer[a / 64] >> (a % 64)) & 1;
+    int answerB = (order->isAnswer[b / 64] >> (b % 64)) & 1;
+    if (answerA != answerB) {
+        return answerB - answerA;
+    }
+    int stride = order->bucket->len + 1;
+    return strcmp(order->bucket->words + (size_t) a * stride,
+            order->bucket->words + (size_t) b * stride);
+}
+
+/* static int open_feedback_matrix(const WordBucket *bucket, int threads,
+*        FeedbackMatrix *matrix)
+* -----------------------------------------------
+* Maps the cached feedback matrix of a bucket, building and caching it
+* first if it is missing or out of date
+*
+* bucket: the bucket
+* threads: maximum number of threads to build the matrix with
+* matrix: receives the matrix
+*
+* Returns: 1 if the matrix is available, 0 if it is too large or there is
+*          no cache to keep it in
+* Errors: -
+*/
+static int open_feedback_matrix(const WordBucket *bucket, int threads,
+        FeedbackMatrix *matrix)
+{
+    const char *env = getenv("WORDLE_MATRIX_MAX_MB");
+    size_t maxSize = (size_t) (env ? atol(env) : DEFAULT_MATRIX_MAX_MB)
+            * 1024 * 1024;
+    int codeBytes = get_code_count(bucket->len) <= 256 ? 1 : 2;
+    size_t size = (size_t) bucket->count * bucket->count * codeBytes;
+    char sourcePath[PATH_MAX], cachePath[PATH_MAX], extension[16];
+    snprintf(extension, sizeof(extension), "fb%d", bucket->len);
+    if (bucket->count == 0 || size > maxSize
+            || !realpath(get_dictionary_path(), sourcePath)
+            || !get_cache_path(sourcePath, extension, cachePath,
+            sizeof(cachePath))) {
+        return 0;
+    }
+    MatrixHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MATRIX_MAGIC, sizeof(header.magic));
+    header.version = MATRIX_VERSION;
+    header.len = bucket->len;
+    header.count = bucket->count;
+    header.codeBytes = codeBytes;
+    header.wordsHash = hash_bytes(bucket->words,
+            (size_t) bucket->count * (bucket->len + 1));
+    memset(matrix, 0, sizeof(*matrix));
+    matrix->codeBytes = codeBytes;
+    if (load_feedback_matrix(cachePath, &header, matrix)) {
+        return 1;
+    }
+    matrix->built = malloc(size);
+    if (matrix->built == 0) {
+        return 0;
+    }
+    MatrixBuild build = {bucket, matrix->built, codeBytes, threads};
+    if ((uint32_t) build.chunkCount > bucket->count) {
+        build.chunkCount = bucket->count;
+    }
+    run_parallel(build.chunkCount, build_matrix_rows, &build);
+    MatrixFile matrixFile = {&header, matrix->built, size};
+    write_cache_file(cachePath, write_matrix_file, &matrixFile);
+    matrix->codes = matrix->built;
+    return 1;
+}
+
+/* static int load_feedback_matrix(const char *path,
+*        const MatrixHeader *header, FeedbackMatrix *matrix)
+* -----------------------------------------------
+* Maps a cached feedback matrix if it was built for the same words
+*
+* path: path of the cached matrix
+* header: the header the matrix must have
+* matrix: receives the mapping
+*
+* Returns: 1 if the matrix was mapped, 0 otherwise
+* Errors: -
+*/
+static int load_feedback_matrix(const char *path, const MatrixHeader *header,
+        FeedbackMatrix *matrix)
+{
+    MatrixHeader stored;
+    struct stat st;
+    size_t size = sizeof(MatrixHeader)
+            + (size_t) header->count * header->count * header->codeBytes;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size != size
+            || pread(fd, &stored, sizeof(stored), 0) != sizeof(stored)
+            || memcmp(&stored, header, sizeof(stored)) != 0) {
+        close(fd);
+        return 0;
+    }
+    void *mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return 0;
+    }
+    matrix->mapping = mapping;
+    matrix->mappingSize = size;
+    matrix->codes = (const char *) mapping + sizeof(MatrixHeader);
+    return 1;
+}
+
+/* static void build_matrix_rows(int chunk, void *context)
+* -----------------------------------------------
+* Fills in one chunk of rows of a feedback matrix. Runs on its own thread.
+*
+* chunk: index of the chunk
+* context: the MatrixBuild
+*
+* Returns: -
+* Errors: -
+*/
+static void build_matrix_rows(int chunk, void *context)
+{
+    MatrixBuild *build = context;
+    const WordBucket *bucket = build->bucket;
+    int stride = bucket->len + 1;
+    uint32_t first = (uint64_t) bucket->count * chunk / build->chunkCount;
+    uint32_t end = (uint64_t) bucket->count * (chunk + 1)
+            / build->chunkCount;
+    for (uint32_t guess = first; guess < end; guess++) {
+        const char *word = bucket->words + (size_t) guess * stride;
+        size_t row = (size_t) guess * bucket->count;
+        for (uint32_t answer = 0; answer < bucket->count; answer++) {
+            uint32_t code = get_feedback_code(word,
+                    bucket->words + (size_t) answer * stride, bucket->len);
+            if (build->codeBytes == 1) {
+                ((uint8_t *) build->codes)[row + answer] = code;
+            } else {
+                ((uint16_t *) build->codes)[row + answer] = code;
+            }
+        }
+    }
+}
+
+/* static int write_matrix_file(FILE *file, const void *context)
+* -----------------------------------------------
+* Writes a feedback matrix to its cache file (see write_cache_file())
+*
+* file: the file being written
+* context: the MatrixFile to write
+*
+* Returns: 1 if every write succeeded, 0 otherwise
+* Errors: -
+*/
+static int write_matrix_file(FILE *file, const void *context)
+{
+    const MatrixFile *matrixFile = context;
+    return fwrite(matrixFile->header, sizeof(*matrixFile->header), 1, file)
+            == 1 && fwrite(matrixFile->codes, 1, matrixFile->size, file)
+            == matrixFile->size;
+}
+
+/* static void close_feedback_matrix(FeedbackMatrix *matrix)
+* -----------------------------------------------
+* Releases the memory (or mapping) holding a feedback matrix
+*
+* matrix: the matrix
+*
+* Returns: -
+* Errors: -
+*/
+static void close_feedback_matrix(FeedbackMatrix *matrix)
+{
+    if (matrix->mapping) {
+        munmap(matrix->mapping, matrix->mappingSize);
+    }
+    free(matrix->built);
+}
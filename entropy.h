@@ -0,0 +1,25 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef ENTROPY_H
+#define ENTROPY_H
+
+#include <stdint.h>
+#include "wordindex.h"
+#include "scan.h"
+
+/*
+* Function Prototypes
+*/
+uint32_t get_feedback_code(const char *guess, const char *answer, int len);
+int rank_guesses_by_entropy(const WordBucket *bucket,
+        const CandidateList *answers, int threads, int limit,
+        CandidateList *guesses);
+int rank_guesses_across_boards(const WordBucket *bucket,
+        const CandidateList *boards, int boardCount, int threads,
+        int limit, CandidateList *guesses);
+void score_guess_entropies(const WordBucket *bucket,
+        const uint32_t *guessIds, int guessCount, const uint32_t *answerIds,
+        int answerCount, int threads, double *entropies);
+
+#endif
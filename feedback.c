@@ -0,0 +1,226 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <string.h>
+#include <ctype.h>
+#include "feedback.h"
+
+// Feedback is written as the guess, a colon and one mark per letter: G for
+// a letter in the right place, Y for a letter elsewhere in the answer and B
+// for a letter the answer has no more of, e.g. "crane:BYBBG".
+#define FEEDBACK_SEPARATOR ':'
+
+/* void init_feedback_constraints(FeedbackConstraints *feedback)
+* -----------------------------------------------
+* Initialises constraints that say nothing about the answer yet
+*
+* feedback: the constraints to initialise
+*
+* Returns: -
+* Errors: -
+*/
+void init_feedback_constraints(FeedbackConstraints *feedback)
+{
+    memset(feedback, 0, sizeof(*feedback));
+    memset(feedback->maxCounts, NO_MAX_COUNT, sizeof(feedback->maxCounts));
+}
+
+/* int add_feedback(FeedbackConstraints *feedback, const char *arg)
+* -----------------------------------------------
+* Adds the feedback to one guess to the constraints. Feedback from several
+* guesses narrows the constraints down further; feedback that contradicts
+* itself or earlier feedback marks the constraints impossible.
+*
+* feedback: the constraints to update
+* arg: the guess and its marks, as in "crane:BYBBG" (either case)
+*
+* Returns: 1 if the feedback is valid, 0 if it is malformed or its guess
+*          length differs from earlier guesses
+* Errors: -
+*/
+int add_feedback(FeedbackConstraints *feedback, const char *arg)
+{
+    const char *separator = strchr(arg, FEEDBACK_SEPARATOR);
+    if (separator == 0) {
+        return 0;
+    }
+    int len = separator - arg;
+    const char *marks = separator + 1;
+    if (len < MIN_LEN || len > MAX_LEN || (int) strlen(marks) != len
+            || (feedback->len && feedback->len != len)) {
+        return 0;
+    }
+    uint8_t present[ALPHABET_SIZE];
+    uint32_t absent = 0;
+    memset(present, 0, sizeof(present));
+    for (int pos = 0; pos < len; pos++) {
+        char mark = toupper(marks[pos]);
+        if (!isalpha(arg[pos]) || (mark != 'G' && mark != 'Y'
+                && mark != 'B')) {
+            return 0;
+        }
+    }
+    for (int pos = 0; pos < len; pos++) {
+        char letter = toupper(arg[pos]);
+        int index = letter - 'A';
+        char mark = toupper(marks[pos]);
+        if (mark == 'G') {
+            if (feedback->fixedAt[pos] && feedback->fixedAt[pos] != letter) {
+                // Two different letters cannot both be at pos
+                feedback->impossible = 1;
+            }
+            feedback->fixedAt[pos] = letter;
+            present[index]++;
+        } else {
+            // Yellow or black, the letter is not at this position
+            feedback->excludedAt[pos] |= 1u << index;
+            if (mark == 'Y') {
+                present[index]++;
+                // Yellow goes to the first misplaced copies of a letter,
+                // so no answer marks a copy black and a later one yellow
+                if (absent & (1u << index)) {
+                    feedback->impossible = 1;
+                }
+            } else {
+                absent |= 1u << index;
+            }
+        }
+    }
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        if (present[letter] > feedback->minCounts[letter]) {
+            feedback->minCounts[letter] = present[letter];
+        }
+        // A black mark means the answer has no more of the letter than
+        // the guess has marked green or yellow
+        if ((absent & (1u << letter))
+                && present[letter] < feedback->maxCounts[letter]) {
+            feedback->maxCounts[letter] = present[letter];
+        }
+    }
+    if (feedback->guessCount < MAX_FEEDBACK_HISTORY) {
+        char *guess = feedback->guesses[feedback->guessCount];
+        uint32_t code = 0;
+        for (int pos = len - 1; pos >= 0; pos--) {
+            char mark = toupper(marks[pos]);
+            code = code * 3 + (mark == 'G' ? 2 : mark == 'Y');
+            guess[pos] = toupper(arg[pos]);
+        }
+        guess[len] = '\0';
+        feedback->codes[feedback->guessCount] = code;
+    }
+    feedback->guessCount++;
+    feedback->len = len;
+    return 1;
+}
+
+/* int add_board_feedback(FeedbackConstraints *boards, int boardCount,
+*        uint32_t *solved, const char *arg)
+* -----------------------------------------------
+* Adds the feedback to one guess played on several boards at once, written
+* as the guess and the marks of each board in turn, as in
+* "crane:BYBBG,GGBBB" for two boards. A board is solved once its marks are
+* all G; the marks given for it after that are ignored and may be empty.
+*
+* boards: the constraints of each board
+* boardCount: number of boards
+* solved: bit b is set once board b is solved
+* arg: the guess and its marks
+*
+* Returns: 1 if the feedback is valid, 0 if it does not give marks for
+*          every board or the marks of an unsolved board are not valid
+*          feedback (see add_feedback())
+* Errors: -
+*/
+int add_board_feedback(FeedbackConstraints *boards, int boardCount,
+        uint32_t *solved, const char *arg)
+{
+    const char *separator = strchr(arg, FEEDBACK_SEPARATOR);
+    if (separator == 0 || separator - arg < MIN_LEN
+            || separator - arg > MAX_LEN) {
+        return 0;
+    }
+    int len = separator - arg;
+    char single[2 * MAX_LEN + 2];
+    memcpy(single, arg, len + 1);
+    const char *marks = separator + 1;
+    for (int board = 0; board < boardCount; board++) {
+        const char *end = strchr(marks, BOARD_SEPARATOR);
+        if ((end == 0) != (board == boardCount - 1)) {
+            return 0;
+        }
+        size_t markCount = end ? (size_t) (end - marks) : strlen(marks);
+        if (!(*solved & (1u << board))) {
+            if (markCount != (size_t) len) {
+                return 0;
+            }
+            memcpy(single + len + 1, marks, len);
+            single[2 * len + 1] = '\0';
+            if (!add_feedback(&boards[board], single)) {
+                return 0;
+            }
+            if (strspn(marks, "Gg") >= (size_t) len) {
+                *solved |= 1u << board;
+            }
+        }
+        marks += markCount + 1;
+    }
+    return 1;
+}
+
+/* int apply_feedback_constraints(const FeedbackConstraints *feedback,
+*        const char *patternString, LetterRequirements *requirements)
+* -----------------------------------------------
+* Adds feedback constraints to requirements compiled from -with and
+* -without, so they are checked by the same kernels. Minimum counts become
+* -with letters and letters that cannot occur become -without letters.
+* Known letters the pattern does not fix already become fixed letters.
+*
+* feedback: the constraints
+* patternString: uppercase pattern, or NULL if no pattern was given
+* requirements: requirements from compile_letter_requirements(), updated
+*
+* Returns: 1, or 0 if no word can meet the constraints: the feedback is
+*          impossible or a known letter differs from the pattern's. The
+*          requirements are then left unfinished.
+* Errors: -
+*/
+int apply_feedback_constraints(const FeedbackConstraints *feedback,
+        const char *patternString, LetterRequirements *requirements)
+{
+    if (feedback->impossible) {
+        return 0;
+    }
+    for (int pos = 0; pos < feedback->len; pos++) {
+        char fixed = feedback->fixedAt[pos];
+        int patternFixed = patternString && patternString[pos] != '_';
+        if (fixed && patternFixed && patternString[pos] != fixed) {
+            return 0;
+        } else if (fixed && !patternFixed) {
+            requirements->fixedAt[pos] = fixed;
+        }
+        requirements->excludedAt[pos] |= feedback->excludedAt[pos];
+    }
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        uint8_t minCount = feedback->minCounts[letter];
+        uint8_t maxCount = feedback->maxCounts[letter];
+        if (minCount > requirements->withExact[letter]) {
+            requirements->withExact[letter] = minCount;
+            requirements->withMask |= 1u << letter;
+            if (minCount > COUNT_SATURATE) {
+                requirements->withOverflow = 1;
+            }
+        }
+        if (maxCount == 0) {
+            requirements->withoutMask |= 1u << letter;
+        }
+        if (maxCount < requirements->maxExact[letter]) {
+            requirements->maxExact[letter] = maxCount;
+        }
+    }
+    // Letters that are nowhere in the answer need no positional test
+    for (int pos = 0; pos < feedback->len; pos++) {
+        requirements->excludedAt[pos] &= ~requirements->withoutMask;
+    }
+    set_letter_count_limits(requirements);
+    return 1;
+}
@@ -0,0 +1,52 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <stdint.h>
+#include "wordle.h"
+#include "lettermask.h"
+
+// Guesses of a query remembered in the order they were given
+#define MAX_FEEDBACK_HISTORY 16
+// Boards a -boards query can play at once (one bit each in a uint32_t),
+// and the guesses it can give feedback for
+#define MAX_BOARDS 32
+#define MAX_BOARD_GUESSES 48
+// Separates the marks of each board in multi-board feedback
+#define BOARD_SEPARATOR ','
+
+/*
+* Struct Definition
+*/
+// What the -feedback arguments of a query say about the answer: the letter
+// known to be at each position (0 if none), the letters known not to be at
+// each position, and how often each letter occurs at least and at most.
+// len is 0 until the first feedback is added. impossible is set once the
+// feedback contradicts itself, so no word can meet it. The first guesses
+// are also kept as given, each with its marks as a feedback code (see
+// entropy.c).
+typedef struct {
+    int len;
+    int impossible;
+    char fixedAt[MAX_LEN];
+    uint32_t excludedAt[MAX_LEN];
+    uint8_t minCounts[ALPHABET_SIZE];
+    uint8_t maxCounts[ALPHABET_SIZE];
+    int guessCount;
+    char guesses[MAX_FEEDBACK_HISTORY][MAX_LEN + 1];
+    uint32_t codes[MAX_FEEDBACK_HISTORY];
+} FeedbackConstraints;
+
+/*
+* Function Prototypes
+*/
+void init_feedback_constraints(FeedbackConstraints *feedback);
+int add_feedback(FeedbackConstraints *feedback, const char *arg);
+int add_board_feedback(FeedbackConstraints *boards, int boardCount,
+        uint32_t *solved, const char *arg);
+int apply_feedback_constraints(const FeedbackConstraints *feedback,
+        const char *patternString, LetterRequirements *requirements);
+
+#endif
@@ -0,0 +1,371 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdlib.h>
+#include <string.h>
+#include "filterkernel.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+// The column kernels read the bucket's structure-of-arrays layout: column
+// pos holds letter pos of every word, so a pattern position is checked for
+// 16 or 32 words with one compare. -with/-without are checked on the
+// per-word letter masks. Letters feedback rules out at a position cost one
+// compare each, like fixed letters. The tests run in the order of the
+// query's predicate plan, and a group of words stops being tested as soon
+// as none of them is left. Every kernel produces one result bit per word.
+
+/*
+* Struct Definitions
+*/
+// One test of the column kernels: a column compared against a letter, for
+// words that must (equal) or must not have it there, or, if column is NULL,
+// every -with/-without letter tested on the letter masks at once
+typedef struct {
+    const char *column;
+    char letter;
+    int equal;
+} ColumnTest;
+
+// A query compiled for the column kernels
+typedef struct {
+    int testCount;
+    ColumnTest tests[MAX_PREDICATES];
+    uint32_t withMask;
+    uint32_t withoutMask;
+} ColumnFilter;
+
+typedef void (*BlockKernel)(const WordBucket *bucket,
+        const ColumnFilter *filter, uint32_t first, uint32_t end,
+        uint64_t *result);
+
+/*
+* Function Prototypes
+*/
+static void compile_column_filter(const WordBucket *bucket,
+        const PredicatePlan *plan, ColumnFilter *filter);
+static void scalar_kernel(const WordBucket *bucket,
+        const ColumnFilter *filter, uint32_t first, uint32_t end,
+        uint64_t *result);
+static BlockKernel select_kernel(void);
+#ifdef HAVE_X86_KERNELS
+static void sse2_kernel(const WordBucket *bucket, const ColumnFilter *filter,
+        uint32_t first, uint32_t end, uint64_t *result);
+static void avx2_kernel(const WordBucket *bucket, const ColumnFilter *filter,
+        uint32_t first, uint32_t end, uint64_t *result);
+#endif
+
+static BlockKernel selectedKernel;
+static const char *selectedKernelName;
+static int selectedKernelWidth;
+
+/* const char *get_filter_kernel_name(void)
+* -----------------------------------------------
+* Name of the column kernel chosen for this CPU
+*
+* Returns: "avx2", "sse2" or "scalar"
+* Errors: -
+*/
+const char *get_filter_kernel_name(void)
+{
+    select_kernel();
+    return selectedKernelName;
+}
+
+/* int prefer_column_scan(const WordBucket *bucket,
+*        const PredicatePlan *plan)
+* -----------------------------------------------
+* Decides between the positional bitsets and a column scan. ANDing bitsets
+* costs one operation per bitset per 64 words; the column scan costs one
+* compare per fixed pattern letter plus one mask test per vector of words.
+* Queries with many -with/-without letters and few fixed letters are
+* cheaper to scan.
+*
+* bucket: bucket being queried
+* plan: the tests of the query
+*
+* Returns: 1 if the column scan is expected to be cheaper, 0 otherwise
+* Errors: -
+*/
+int prefer_column_scan(const WordBucket *bucket, const PredicatePlan *plan)
+{
+    ColumnFilter filter;
+    compile_column_filter(bucket, plan, &filter);
+    select_kernel();
+    int maskTests = (filter.withMask || filter.withoutMask) ? 2 : 0;
+    int columnTests = filter.testCount - (maskTests ? 1 : 0);
+    // Operations per 64 words for each approach, one bitset per test
+    return plan->count * selectedKernelWidth
+            > (columnTests + maskTests) * 64;
+}
+
+/* void filter_bucket_columns(const WordBucket *bucket,
+*        const PredicatePlan *plan, uint32_t first, uint32_t end,
+*        uint64_t *result)
+* -----------------------------------------------
+* Evaluates the pattern, the positional feedback and the -with/-without
+* presence tests for words first..end-1 with the fastest kernel the CPU
+* supports. Letter counts are not checked here, as with
+* match_position_bitsets().
+*
+* bucket: bucket with column data
+* plan: the tests of the query, in the order they are run
+* first: first word to filter, a multiple of 64
+* end: one past the last word to filter
+* result: receives one bit per word from first to end-1 (bit 0 of result[0]
+*         is word first)
+*
+* Returns: -
+* Errors: -
+*/
+void filter_bucket_columns(const WordBucket *bucket,
+        const PredicatePlan *plan, uint32_t first, uint32_t end,
+        uint64_t *result)
+{
+    ColumnFilter filter;
+    compile_column_filter(bucket, plan, &filter);
+    BlockKernel kernel = select_kernel();
+    // Vector kernels handle whole blocks of 64 words, the tail is scalar
+    uint32_t wholeEnd = first + (end - first) / 64 * 64;
+    if (wholeEnd > first) {
+        kernel(bucket, &filter, first, wholeEnd, result);
+    }
+    if (end > wholeEnd) {
+        scalar_kernel(bucket, &filter, wholeEnd, end,
+                result + (wholeEnd - first) / 64);
+    }
+}
+
+/* static void compile_column_filter(const WordBucket *bucket,
+*        const PredicatePlan *plan, ColumnFilter *filter)
+* -----------------------------------------------
+* Turns the tests of a query into column tests, in the plan's order. The
+* -with/-without letters are all tested together on the letter masks, where
+* the plan has the first of them.
+*
+* bucket: bucket being queried
+* plan: the tests of the query
+* filter: receives the compiled filter
+*
+* Returns: -
+* Errors: -
+*/
+static void compile_column_filter(const WordBucket *bucket,
+        const PredicatePlan *plan, ColumnFilter *filter)
+{
+    filter->testCount = 0;
+    filter->withMask = filter->withoutMask = 0;
+    for (int p = 0; p < plan->count; p++) {
+        const Predicate *predicate = &plan->predicates[p];
+        int masks = predicate->kind == PREDICATE_WITH
+                || predicate->kind == PREDICATE_WITHOUT;
+        if (masks && (filter->withMask || filter->withoutMask)) {
+            // Already tested along with an earlier letter
+        } else if (masks) {
+            filter->tests[filter->testCount].column = 0;
+            filter->testCount++;
+        } else {
+            ColumnTest *test = &filter->tests[filter->testCount++];
+            test->column = bucket->columns
+                    + (size_t) predicate->pos * bucket->count;
+            test->letter = 'A' + predicate->letter;
+            test->equal = predicate->kind == PREDICATE_FIXED;
+        }
+        if (predicate->kind == PREDICATE_WITH) {
+            filter->withMask |= 1u << predicate->letter;
+        } else if (predicate->kind == PREDICATE_WITHOUT) {
+            filter->withoutMask |= 1u << predicate->letter;
+        }
+    }
+}
+
+/* static void scalar_kernel(const WordBucket *bucket,
+*        const ColumnFilter *filter, uint32_t first, uint32_t end,
+*        uint64_t *result)
+* -----------------------------------------------
+* Evaluates the filter one word at a time. This is the portable reference
+* for the vector kernels; WORDLE_KERNEL=scalar forces it. make test checks
+* every kernel against the reference filters of test/reference.c.
+*
+* bucket: bucket with column data
+* filter: the compiled filter
+* first: first word, a multiple of 64
+* end: one past the last word
+* result: receives one bit per word from first to end-1
+*
+* Returns: -
+* Errors: -
+*/
+static void scalar_kernel(const WordBucket *bucket,
+        const ColumnFilter *filter, uint32_t first, uint32_t end,
+        uint64_t *result)
+{
+    uint64_t bits = 0;
+    for (uint32_t i = first; i < end; i++) {
+        int matches = 1;
+        for (int t = 0; t < filter->testCount && matches; t++) {
+            const ColumnTest *test = &filter->tests[t];
+            if (test->column) {
+                matches = (test->column[i] == test->letter) == test->equal;
+            } else {
+                uint32_t mask = bucket->masks[i];
+                matches = !(mask & filter->withoutMask)
+                        && (mask & filter->withMask) == filter->withMask;
+            }
+        }
+        bits |= (uint64_t) matches << (i % 64);
+        if (i % 64 == 63 || i == end - 1) {
+            result[(i - first) / 64] = bits;
+            bits = 0;
+        }
+    }
+}
+
+/* static BlockKernel select_kernel(void)
+* -----------------------------------------------
+* Picks the column kernel once, based on the CPU the program runs on. The
+* WORDLE_KERNEL environment variable ("scalar", "sse2" or "avx2") can force
+* a kernel the CPU supports.
+*
+* Returns: the kernel to use
+* Errors: -
+*/
+static BlockKernel select_kernel(void)
+{
+    if (selectedKernel) {
+        return selectedKernel;
+    }
+    const char *forced = getenv("WORDLE_KERNEL");
+    selectedKernel = scalar_kernel;
+    selectedKernelName = "scalar";
+    selectedKernelWidth = 1;
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (forced && strcmp(forced, "scalar") == 0) {
+        return selectedKernel;
+    }
+    if (__builtin_cpu_supports("avx2")
+            && !(forced && strcmp(forced, "sse2") == 0)) {
+        selectedKernel = avx2_kernel;
+        selectedKernelName = "avx2";
+        selectedKernelWidth = 32;
+    } else if (__builtin_cpu_supports("sse2")) {
+        selectedKernel = sse2_kernel;
+        selectedKernelName = "sse2";
+        selectedKernelWidth = 16;
+    }
+#else
+    (void) forced;
+#endif
+    return selectedKernel;
+}
+
+#ifdef HAVE_X86_KERNELS
+/* static void sse2_kernel(const WordBucket *bucket,
+*        const ColumnFilter *filter, uint32_t first, uint32_t end,
+*        uint64_t *result)
+* -----------------------------------------------
+* Evaluates the filter 16 words at a time with SSE2
+*
+* bucket, filter, first, result: as for scalar_kernel()
+* end: one past the last word, first + a multiple of 64
+*
+* Returns: -
+* Errors: -
+*/
+__attribute__((target("sse2")))
+static void sse2_kernel(const WordBucket *bucket, const ColumnFilter *filter,
+        uint32_t first, uint32_t end, uint64_t *result)
+{
+    const __m128i withMask = _mm_set1_epi32(filter->withMask);
+    const __m128i withoutMask = _mm_set1_epi32(filter->withoutMask);
+    const __m128i zero = _mm_setzero_si128();
+    for (uint32_t block = first; block < end; block += 64) {
+        uint64_t bits = 0;
+        for (uint32_t i = block; i < block + 64; i += 16) {
+            uint32_t group = 0xffff;
+            for (int t = 0; t < filter->testCount && group; t++) {
+                const ColumnTest *test = &filter->tests[t];
+                if (test->column) {
+                    __m128i letters = _mm_loadu_si128((const __m128i *)
+                            (test->column + i));
+                    uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(
+                            letters, _mm_set1_epi8(test->letter)));
+                    group &= test->equal ? equal : ~equal;
+                    continue;
+                }
+                uint32_t maskBits = 0;
+                for (int k = 0; k < 16; k += 4) {
+                    __m128i masks = _mm_loadu_si128((const __m128i *)
+                            (bucket->masks + i + k));
+                    __m128i ok = _mm_and_si128(
+                            _mm_cmpeq_epi32(_mm_and_si128(masks,
+                            withoutMask), zero),
+                            _mm_cmpeq_epi32(_mm_and_si128(masks, withMask),
+                            withMask));
+                    maskBits |= (uint32_t) _mm_movemask_ps(
+                            _mm_castsi128_ps(ok)) << k;
+                }
+                group &= maskBits;
+            }
+            bits |= (uint64_t) group << (i - block);
+        }
+        result[(block - first) / 64] = bits;
+    }
+}
+
+/* static void avx2_kernel(const WordBucket *bucket,
+*        const ColumnFilter *filter, uint32_t first, uint32_t end,
+*        uint64_t *result)
+* -----------------------------------------------
+* Evaluates the filter 32 words at a time with AVX2
+*
+* bucket, filter, first, result: as for scalar_kernel()
+* end: one past the last word, first + a multiple of 64
+*
+* Returns: -
+* Errors: -
+*/
+__attribute__((target("avx2")))
+static void avx2_kernel(const WordBucket *bucket, const ColumnFilter *filter,
+        uint32_t first, uint32_t end, uint64_t *result)
+{
+    const __m256i withMask = _mm256_set1_epi32(filter->withMask);
+    const __m256i withoutMask = _mm256_set1_epi32(filter->withoutMask);
+    const __m256i zero = _mm256_setzero_si256();
+    for (uint32_t block = first; block < end; block += 64) {
+        uint64_t bits = 0;
+        for (uint32_t i = block; i < block + 64; i += 32) {
+            uint32_t group = 0xffffffff;
+            for (int t = 0; t < filter->testCount && group; t++) {
+                const ColumnTest *test = &filter->tests[t];
+                if (test->column) {
+                    __m256i letters = _mm256_loadu_si256((const __m256i *)
+                            (test->column + i));
+                    uint32_t equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            letters, _mm256_set1_epi8(test->letter)));
+                    group &= test->equal ? equal : ~equal;
+                    continue;
+                }
+                uint32_t maskBits = 0;
+                for (int k = 0; k < 32; k += 8) {
+                    __m256i masks = _mm256_loadu_si256((const __m256i *)
+                            (bucket->masks + i + k));
+                    __m256i ok = _mm256_and_si256(
+                            _mm256_cmpeq_epi32(_mm256_and_si256(masks,
+                            withoutMask), zero),
+                            _mm256_cmpeq_epi32(_mm256_and_si256(masks,
+                            withMask), withMask));
+                    maskBits |= (uint32_t) _mm256_movemask_ps(
+                            _mm256_castsi256_ps(ok)) << k;
+                }
+                group &= maskBits;
+            }
+            bits |= (uint64_t) group << (i - block);
+        }
+        result[(block - first) / 64] = bits;
+    }
+}
+#endif
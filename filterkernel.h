@@ -0,0 +1,21 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef FILTERKERNEL_H
+#define FILTERKERNEL_H
+
+#include <stdint.h>
+#include "lettermask.h"
+#include "wordindex.h"
+#include "predicate.h"
+
+/*
+* Function Prototypes
+*/
+const char *get_filter_kernel_name(void);
+int prefer_column_scan(const WordBucket *bucket, const PredicatePlan *plan);
+void filter_bucket_columns(const WordBucket *bucket,
+        const PredicatePlan *plan, uint32_t first, uint32_t end,
+        uint64_t *result);
+
+#endif
@@ -0,0 +1,237 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <string.h>
+#include "lettermask.h"
+
+/*
+* Function Prototypes
+*/
+static void add_packed_count(LetterCounts *counts, int letter, int count);
+
+/* uint32_t get_letter_mask(const char *word)
+* -----------------------------------------------
+* Computes the letter presence mask of an uppercase word, including the
+* LETTER_OVERFLOW_BIT if a letter occurs more than COUNT_SATURATE times
+*
+* word: NUL terminated uppercase word
+*
+* Returns: the letter mask
+* Errors: -
+*/
+uint32_t get_letter_mask(const char *word)
+{
+    uint8_t seen[ALPHABET_SIZE];
+    uint32_t mask = 0;
+    memset(seen, 0, sizeof(seen));
+    for (int i = 0; word[i]; i++) {
+        int letter = word[i] - 'A';
+        mask |= 1u << letter;
+        if (++seen[letter] > COUNT_SATURATE) {
+            mask |= LETTER_OVERFLOW_BIT;
+        }
+    }
+    return mask;
+}
+
+/* uint64_t pack_word(const char *word, int len)
+* -----------------------------------------------
+* Packs an uppercase word into an integer (see LETTER_BITS)
+*
+* word: uppercase word
+* len: length of the word
+*
+* Returns: the packed word
+* Errors: -
+*/
+uint64_t pack_word(const char *word, int len)
+{
+    uint64_t packed = 0;
+    for (int i = 0; i < len; i++) {
+        packed = (packed << LETTER_BITS) | (uint64_t) (word[i] - 'A');
+    }
+    return packed;
+}
+
+/* void unpack_word(uint64_t packed, int len, char *word)
+* -----------------------------------------------
+* Turns a packed word back into its letters
+*
+* packed: the packed word
+* len: length of the word
+* word: receives the NUL terminated word; room for len + 1 characters
+*
+* Returns: -
+* Errors: -
+*/
+void unpack_word(uint64_t packed, int len, char *word)
+{
+    for (int i = len - 1; i >= 0; i--, packed >>= LETTER_BITS) {
+        word[i] = 'A' + (packed & LETTER_FIELD);
+    }
+    word[len] = '\0';
+}
+
+/* LetterCounts get_letter_counts(const char *word)
+* -----------------------------------------------
+* Computes the packed per-letter counts of an uppercase word. Counts above
+* COUNT_SATURATE are stored as COUNT_SATURATE.
+*
+* word: NUL terminated uppercase word
+*
+* Returns: the packed counts
+* Errors: -
+*/
+LetterCounts get_letter_counts(const char *word)
+{
+    uint8_t seen[ALPHABET_SIZE];
+    LetterCounts counts = {0, 0};
+    memset(seen, 0, sizeof(seen));
+    for (int i = 0; word[i]; i++) {
+        seen[word[i] - 'A']++;
+    }
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        add_packed_count(&counts, letter, seen[letter]);
+    }
+    return counts;
+}
+
+/* void compile_letter_requirements(const char *withString,
+*        const char *withoutString, LetterRequirements *requirements)
+* -----------------------------------------------
+* Compiles the -with and -without arguments into presence masks and a packed
+* vector of required counts, so each candidate can be checked with a few
+* mask tests and one SWAR comparison. No letter has an upper bound other
+* than the -without letters.
+*
+* withString: uppercase value of the -with argument ("" if not given)
+* withoutString: uppercase value of the -without argument ("" if not given)
+* requirements: receives the compiled requirements
+*
+* Returns: -
+* Errors: -
+*/
+void compile_letter_requirements(const char *withString,
+        const char *withoutString, LetterRequirements *requirements)
+{
+    memset(requirements, 0, sizeof(*requirements));
+    memset(requirements->maxExact, NO_MAX_COUNT,
+            sizeof(requirements->maxExact));
+    for (int i = 0; withString[i]; i++) {
+        int letter = withString[i] - 'A';
+        requirements->withMask |= 1u << letter;
+        if (++requirements->withExact[letter] > COUNT_SATURATE) {
+            requirements->withOverflow = 1;
+        }
+    }
+    for (int i = 0; withoutString[i]; i++) {
+        requirements->withoutMask |= 1u << (withoutString[i] - 'A');
+    }
+    set_letter_count_limits(requirements);
+}
+
+/* void set_letter_count_limits(LetterRequirements *requirements)
+* -----------------------------------------------
+* Packs the exact lower and upper count bounds of the requirements into the
+* vectors the SWAR comparisons use. Bounds a 4-bit field cannot represent
+* are checked by counting the letters of the word instead.
+*
+* requirements: requirements whose withExact and maxExact are filled in
+*
+* Returns: -
+* Errors: -
+*/
+void set_letter_count_limits(LetterRequirements *requirements)
+{
+    requirements->withCounts.lo = requirements->withCounts.hi = 0;
+    requirements->maxCounts.lo = requirements->maxCounts.hi = 0;
+    requirements->checkMax = requirements->maxOverflow = 0;
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        uint8_t maxCount = requirements->maxExact[letter];
+        add_packed_count(&requirements->withCounts, letter,
+                requirements->withExact[letter]);
+        add_packed_count(&requirements->maxCounts, letter, maxCount);
+        // -without letters are caught by the mask test
+        if (maxCount > 0 && maxCount != NO_MAX_COUNT) {
+            requirements->checkMax = 1;
+            // A saturated count of 7 may stand for 8 or 9
+            if (maxCount >= COUNT_SATURATE) {
+                requirements->maxOverflow = 1;
+            }
+        }
+    }
+}
+
+/* int matches_letter_requirements(const LetterRequirements *requirements,
+*        uint32_t mask, const LetterCounts *counts, const char *word)
+* -----------------------------------------------
+* Checks a word against compiled -with/-without requirements and the count
+* bounds of any feedback. Without feedback it gives the same answer as the
+* reference filter_words_matching_with() and filter_words_matching_without()
+* in test/reference.c, which make test checks. The positional parts of
+* feedback are left to the filter kernels.
+*
+* requirements: the compiled requirements
+* mask: letter mask of the word
+* counts: packed letter counts of the word
+* word: the word itself, only read when a count bound exceeds what the
+*       packed counts can represent
+*
+* Returns: 1 if the word satisfies the requirements, 0 otherwise
+* Errors: -
+*/
+int matches_letter_requirements(const LetterRequirements *requirements,
+        uint32_t mask, const LetterCounts *counts, const char *word)
+{
+    if (mask & requirements->withoutMask) {
+        return 0;
+    }
+    if ((mask & requirements->withMask) != requirements->withMask
+            || !counts_at_least(counts, &requirements->withCounts)) {
+        return 0;
+    }
+    if (requirements->checkMax
+            && !counts_at_most(counts, &requirements->maxCounts)) {
+        return 0;
+    }
+    if (requirements->withOverflow || (requirements->maxOverflow
+            && (mask & LETTER_OVERFLOW_BIT))) {
+        // Saturated counts cannot tell 7 from 8 or 9, count exactly instead
+        if (!(mask & LETTER_OVERFLOW_BIT)) {
+            return 0;
+        }
+        uint8_t seen[ALPHABET_SIZE];
+        memset(seen, 0, sizeof(seen));
+        for (int i = 0; word[i]; i++) {
+            seen[word[i] - 'A']++;
+        }
+        for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+            if (seen[letter] < requirements->withExact[letter]
+                    || seen[letter] > requirements->maxExact[letter]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* static void add_packed_count(LetterCounts *counts, int letter, int count)
+* -----------------------------------------------
+* Stores a (saturated) count in the 4-bit field of a letter
+*
+* counts: packed counts to update
+* letter: letter index (0 for A)
+* count: number of occurrences
+*
+* Returns: -
+* Errors: -
+*/
+static void add_packed_count(LetterCounts *counts, int letter, int count)
+{
+    uint64_t value = count > COUNT_SATURATE ? COUNT_SATURATE : count;
+    if (letter < 16) {
+        counts->lo |= value << (letter * COUNT_FIELD_BITS);
+    } else {
+        counts->hi |= value << ((letter - 16) * COUNT_FIELD_BITS);
+    }
+}
@@ -0,0 +1,128 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef LETTERMASK_H
+#define LETTERMASK_H
+
+#include <stdint.h>
+#include "wordle.h"
+
+// Bit 0..25 of a letter mask are set for the letters A..Z present in a word.
+// LETTER_OVERFLOW_BIT is set when some letter occurs more often than a packed
+// count can hold.
+#define ALPHABET_SIZE 26
+#define LETTER_OVERFLOW_BIT (1u << ALPHABET_SIZE)
+// Packed counts hold one 4-bit field per letter (A..P in lo, Q..Z in hi).
+// Counts saturate at COUNT_SATURATE so the top bit of every field is free to
+// act as a guard bit for SWAR comparisons.
+#define COUNT_FIELD_BITS 4
+#define COUNT_SATURATE 7
+#define COUNT_GUARD_BITS 0x8888888888888888ull
+#define ALL_LETTERS ((1u << ALPHABET_SIZE) - 1)
+// Upper bound of a letter that may occur any number of times
+#define NO_MAX_COUNT UINT8_MAX
+// A packed word holds one LETTER_BITS field per letter (0 for A), the first
+// letter most significant, so a MAX_LEN letter word fits in 45 bits and
+// packed words of the same length compare like strcmp()
+#define LETTER_BITS 5
+#define LETTER_FIELD ((1u << LETTER_BITS) - 1)
+
+/*
+* Struct Definitions
+*/
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+} LetterCounts;
+
+// The -with and -without arguments compiled into masks and count vectors.
+// Feedback adds letters known to be at (fixedAt, 0 if none) or not at
+// (excludedAt) each position, and upper bounds on the letter counts.
+typedef struct {
+    uint32_t withMask;
+    uint32_t withoutMask;
+    LetterCounts withCounts;
+    int withOverflow;
+    uint8_t withExact[ALPHABET_SIZE];
+    char fixedAt[MAX_LEN];
+    uint32_t excludedAt[MAX_LEN];
+    LetterCounts maxCounts;
+    int checkMax;
+    int maxOverflow;
+    uint8_t maxExact[ALPHABET_SIZE];
+} LetterRequirements;
+
+/*
+* Function Prototypes
+*/
+uint32_t get_letter_mask(const char *word);
+uint64_t pack_word(const char *word, int len);
+void unpack_word(uint64_t packed, int len, char *word);
+LetterCounts get_letter_counts(const char *word);
+void compile_letter_requirements(const char *withString,
+        const char *withoutString, LetterRequirements *requirements);
+void set_letter_count_limits(LetterRequirements *requirements);
+int matches_letter_requirements(const LetterRequirements *requirements,
+        uint32_t mask, const LetterCounts *counts, const char *word);
+
+/* static inline int get_packed_letter(uint64_t packed, int len, int pos)
+* -----------------------------------------------
+* Extracts one letter of a packed word
+*
+* packed: the packed word
+* len: length of the word
+* pos: position of the letter
+*
+* Returns: the letter as 0 for A to 25 for Z
+* Errors: -
+*/
+static inline int get_packed_letter(uint64_t packed, int len, int pos)
+{
+    return (packed >> ((len - 1 - pos) * LETTER_BITS)) & LETTER_FIELD;
+}
+
+/* static inline int counts_at_least(const LetterCounts *counts,
+*        const LetterCounts *required)
+* -----------------------------------------------
+* SWAR comparison of packed letter counts: every 4-bit field of counts is
+* compared against the same field of required in one subtraction per half.
+* Setting the guard bit of each field before subtracting means a field can
+* never borrow from its neighbour, and the guard survives exactly when the
+* count is at least the required count.
+*
+* counts: packed counts of a word
+* required: packed required counts (each at most COUNT_SATURATE)
+*
+* Returns: 1 if every letter occurs at least as often as required, else 0
+* Errors: -
+*/
+static inline int counts_at_least(const LetterCounts *counts,
+        const LetterCounts *required)
+{
+    return ((((counts->lo | COUNT_GUARD_BITS) - required->lo)
+            & ((counts->hi | COUNT_GUARD_BITS) - required->hi))
+            & COUNT_GUARD_BITS) == COUNT_GUARD_BITS;
+}
+
+/* static inline int counts_at_most(const LetterCounts *counts,
+*        const LetterCounts *limits)
+* -----------------------------------------------
+* SWAR comparison of packed letter counts, the other way round from
+* counts_at_least(): the guard bit of a field survives the subtraction
+* exactly when the count is at most the limit
+*
+* counts: packed counts of a word
+* limits: packed largest counts allowed (each at most COUNT_SATURATE)
+*
+* Returns: 1 if no letter occurs more often than allowed, else 0
+* Errors: -
+*/
+static inline int counts_at_most(const LetterCounts *counts,
+        const LetterCounts *limits)
+{
+    return ((((limits->lo | COUNT_GUARD_BITS) - counts->lo)
+            & ((limits->hi | COUNT_GUARD_BITS) - counts->hi))
+            & COUNT_GUARD_BITS) == COUNT_GUARD_BITS;
+}
+
+#endif
@@ -0,0 +1,139 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "output.h"
+
+#define OUTPUT_BUFFER_SIZE (256 * 1024)
+// Longest record the length prefix can describe
+#define MAX_RECORD_SIZE 255
+
+/* void init_output_writer(OutputWriter *writer, int fd, int format)
+* -----------------------------------------------
+* Initialises a writer with an empty buffer
+*
+* writer: the writer to initialise
+* fd: file descriptor the output is written to
+* format: FORMAT_LINES, FORMAT_NUL or FORMAT_LENGTH
+*
+* Returns: -
+* Errors: -
+*/
+void init_output_writer(OutputWriter *writer, int fd, int format)
+{
+    writer->fd = fd;
+    writer->format = format;
+    writer->failed = 0;
+    writer->buffer = malloc(OUTPUT_BUFFER_SIZE);
+    writer->used = 0;
+    writer->capacity = OUTPUT_BUFFER_SIZE;
+}
+
+/* void write_word(OutputWriter *writer, const char *word, int len)
+* -----------------------------------------------
+* Adds a word from a bucket to the output. Bucket words are NUL terminated,
+* so in the line and NUL formats the word and its terminator are copied in
+* one go.
+*
+* writer: the writer
+* word: the NUL terminated word
+* len: length of the word (at most MAX_LEN)
+*
+* Returns: -
+* Errors: -
+*/
+void write_word(OutputWriter *writer, const char *word, int len)
+{
+    if (writer->capacity - writer->used < (size_t) len + 1) {
+        flush_output(writer);
+    }
+    char *out = writer->buffer + writer->used;
+    if (writer->format == FORMAT_LENGTH) {
+        *out++ = len;
+        memcpy(out, word, len);
+    } else {
+        memcpy(out, word, len + 1);
+        if (writer->format == FORMAT_LINES) {
+            out[len] = '\n';
+        }
+    }
+    writer->used += len + 1;
+}
+
+/* void write_record(OutputWriter *writer, const char *data, size_t len)
+* -----------------------------------------------
+* Adds an arbitrary record (such as an error message or an exit status) to
+* the output. Records longer than MAX_RECORD_SIZE are cut short.
+*
+* writer: the writer
+* data: the record, without a terminator
+* len: length of the record
+*
+* Returns: -
+* Errors: -
+*/
+void write_record(OutputWriter *writer, const char *data, size_t len)
+{
+    if (len > MAX_RECORD_SIZE) {
+        len = MAX_RECORD_SIZE;
+    }
+    if (writer->capacity - writer->used < len + 1) {
+        flush_output(writer);
+    }
+    char *out = writer->buffer + writer->used;
+    if (writer->format == FORMAT_LENGTH) {
+        *out++ = len;
+        memcpy(out, data, len);
+    } else {
+        memcpy(out, data, len);
+        out[len] = writer->format == FORMAT_LINES ? '\n' : '\0';
+    }
+    writer->used += len + 1;
+}
+
+/* int flush_output(OutputWriter *writer)
+* -----------------------------------------------
+* Writes out everything in the buffer, retrying short and interrupted
+* writes. Once a write has failed (e.g. the reader went away) further
+* output is discarded.
+*
+* writer: the writer
+*
+* Returns: 0 on success, -1 if the output could not be written
+* Errors: -
+*/
+int flush_output(OutputWriter *writer)
+{
+    size_t done = 0;
+    while (done < writer->used && !writer->failed) {
+        ssize_t written = write(writer->fd, writer->buffer + done,
+                writer->used - done);
+        if (written < 0 && errno != EINTR) {
+            writer->failed = 1;
+        } else if (written > 0) {
+            done += written;
+        }
+    }
+    writer->used = 0;
+    return writer->failed ? -1 : 0;
+}
+
+/* void free_output_writer(OutputWriter *writer)
+* -----------------------------------------------
+* Flushes the writer and releases its buffer. The file descriptor is left
+* open.
+*
+* writer: the writer
+*
+* Returns: -
+* Errors: -
+*/
+void free_output_writer(OutputWriter *writer)
+{
+    flush_output(writer);
+    free(writer->buffer);
+    writer->buffer = 0;
+}
@@ -0,0 +1,38 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+
+// Output formats: one record per line, NUL terminated records, or records
+// preceded by their length as a single byte
+#define FORMAT_LINES 0
+#define FORMAT_NUL 1
+#define FORMAT_LENGTH 2
+
+/*
+* Struct Definition
+*/
+// Records are formatted into one large buffer that is handed to write()
+// only when it fills up or is flushed
+typedef struct {
+    int fd;
+    int format;
+    int failed;
+    char *buffer;
+    size_t used;
+    size_t capacity;
+} OutputWriter;
+
+/*
+* Function Prototypes
+*/
+void init_output_writer(OutputWriter *writer, int fd, int format);
+void write_word(OutputWriter *writer, const char *word, int len);
+void write_record(OutputWriter *writer, const char *data, size_t len);
+int flush_output(OutputWriter *writer);
+void free_output_writer(OutputWriter *writer);
+
+#endif
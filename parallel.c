@@ -0,0 +1,95 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "parallel.h"
+
+/*
+* Struct Definition
+*/
+typedef struct {
+    int chunk;
+    ChunkWorker worker;
+    void *context;
+} ChunkThread;
+
+/*
+* Function Prototypes
+*/
+static void *run_chunk_thread(void *arg);
+
+/* int get_default_thread_count(void)
+* -----------------------------------------------
+* Number of threads used when -threads is not given: one per online core
+*
+* Returns: the number of online cores (at least 1)
+* Errors: -
+*/
+int get_default_thread_count(void)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? cores : 1;
+}
+
+/* void run_parallel(int chunkCount, ChunkWorker worker, void *context)
+* -----------------------------------------------
+* Calls worker(chunk, context) for every chunk in 0..chunkCount-1, each on
+* its own thread (chunk 0 runs on the calling thread), and waits for all of
+* them to finish
+*
+* chunkCount: number of chunks
+* worker: function run for each chunk
+* context: passed through to worker
+*
+* Returns: -
+* Errors: -
+*/
+void run_parallel(int chunkCount, ChunkWorker worker, void *context)
+{
+    if (chunkCount <= 1) {
+        if (chunkCount == 1) {
+            worker(0, context);
+        }
+        return;
+    }
+    pthread_t *threads = malloc(sizeof(pthread_t) * chunkCount);
+    ChunkThread *args = malloc(sizeof(ChunkThread) * chunkCount);
+    int *started = calloc(chunkCount, sizeof(int));
+    for (int i = 1; i < chunkCount; i++) {
+        args[i].chunk = i;
+        args[i].worker = worker;
+        args[i].context = context;
+        started[i] = pthread_create(&threads[i], 0, run_chunk_thread,
+                &args[i]) == 0;
+    }
+    worker(0, context);
+    for (int i = 1; i < chunkCount; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], 0);
+        } else {
+            // Could not get a thread, run the chunk here instead
+            worker(i, context);
+        }
+    }
+    free(started);
+    free(args);
+    free(threads);
+}
+
+/* static void *run_chunk_thread(void *arg)
+* -----------------------------------------------
+* Thread entry point for run_parallel()
+*
+* arg: the ChunkThread describing the chunk
+*
+* Returns: NULL
+* Errors: -
+*/
+static void *run_chunk_thread(void *arg)
+{
+    ChunkThread *chunkThread = arg;
+    chunkThread->worker(chunkThread->chunk, chunkThread->context);
+    return 0;
+}
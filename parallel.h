@@ -0,0 +1,15 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+typedef void (*ChunkWorker)(int chunk, void *context);
+
+/*
+* Function Prototypes
+*/
+int get_default_thread_count(void);
+void run_parallel(int chunkCount, ChunkWorker worker, void *context);
+
+#endif
@@ -0,0 +1,190 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include "predicate.h"
+
+// Every test costs the kernels about the same (one compare per word or per
+// bitset word), so the cheapest order is the most selective test first: a
+// word failing it is dropped before the other tests are run. How selective
+// each test is depends on the dictionary, so it is measured on a sample of
+// the bucket rather than guessed; "-without AEIOU" rejects far more words
+// than a pattern fixing one common letter, and runs first.
+
+/*
+* Function Prototypes
+*/
+static void add_predicate(PredicatePlan *plan, int kind, int pos,
+        int letter);
+static int passes_predicate(const Predicate *predicate, int len,
+        uint64_t packed, uint32_t mask);
+
+/* void list_predicates(const WordBucket *bucket, const char *patternString,
+*        const LetterRequirements *requirements, PredicatePlan *plan)
+* -----------------------------------------------
+* Breaks a query up into its single-letter tests, in a fixed order: the
+* fixed letters and the letters ruled out at each position, position by
+* position, then the -with and -without letters
+*
+* bucket: the bucket the query is for
+* patternString: uppercase pattern, or NULL if no pattern was given
+* requirements: compiled -with/-without and feedback requirements
+* plan: receives the tests, unsampled
+*
+* Returns: -
+* Errors: -
+*/
+void list_predicates(const WordBucket *bucket, const char *patternString,
+        const LetterRequirements *requirements, PredicatePlan *plan)
+{
+    plan->count = 0;
+    plan->sampleSize = 0;
+    for (int pos = 0; pos < bucket->len; pos++) {
+        char fixed = patternString && patternString[pos] != '_'
+                ? patternString[pos] : requirements->fixedAt[pos];
+        if (fixed) {
+            add_predicate(plan, PREDICATE_FIXED, pos, fixed - 'A');
+        }
+    }
+    for (int pos = 0; pos < bucket->len; pos++) {
+        for (uint32_t letters = requirements->excludedAt[pos]; letters;
+                letters &= letters - 1) {
+            add_predicate(plan, PREDICATE_EXCLUDED, pos,
+                    __builtin_ctz(letters));
+        }
+    }
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        if (requirements->withMask & (1u << letter)) {
+            add_predicate(plan, PREDICATE_WITH, 0, letter);
+        }
+    }
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        if (requirements->withoutMask & (1u << letter)) {
+            add_predicate(plan, PREDICATE_WITHOUT, 0, letter);
+        }
+    }
+}
+
+/* void order_predicates(const WordBucket *bucket, PredicatePlan *plan)
+* -----------------------------------------------
+* Runs every test on words spread evenly over the bucket and sorts the tests
+* by how many of them pass, fewest first. Tests that pass equally often
+* keep their order, so the result does not depend on anything but the
+* bucket and the query.
+*
+* bucket: the bucket the query is for
+* plan: the tests, reordered in place
+*
+* Returns: -
+* Errors: -
+*/
+void order_predicates(const WordBucket *bucket, PredicatePlan *plan)
+{
+    int sampleSize = bucket->count < PREDICATE_SAMPLE_WORDS
+            ? (int) bucket->count : PREDICATE_SAMPLE_WORDS;
+    if (sampleSize == 0) {
+        return;
+    }
+    uint32_t stride = bucket->count / sampleSize;
+    for (int p = 0; p < plan->count; p++) {
+        plan->predicates[p].passed = 0;
+    }
+    for (int s = 0; s < sampleSize; s++) {
+        uint32_t i = s * stride;
+        for (int p = 0; p < plan->count; p++) {
+            plan->predicates[p].passed += passes_predicate(
+                    &plan->predicates[p], bucket->len, bucket->packed[i],
+                    bucket->masks[i]);
+        }
+    }
+    // Insertion sort, stable and quick for the few tests of a query
+    for (int p = 1; p < plan->count; p++) {
+        Predicate predicate = plan->predicates[p];
+        int q = p;
+        for (; q > 0 && plan->predicates[q - 1].passed > predicate.passed;
+                q--) {
+            plan->predicates[q] = plan->predicates[q - 1];
+        }
+        plan->predicates[q] = predicate;
+    }
+    plan->sampleSize = sampleSize;
+}
+
+/* int format_predicate(const Predicate *predicate, char *buffer,
+*        size_t size)
+* -----------------------------------------------
+* Describes a test for the -stats output, e.g. "A at 1", "no E at 3",
+* "with S" or "without U" (positions count from 1)
+*
+* predicate: the test
+* buffer: receives the description
+* size: size of buffer
+*
+* Returns: the length of the description
+* Errors: -
+*/
+int format_predicate(const Predicate *predicate, char *buffer, size_t size)
+{
+    char letter = 'A' + predicate->letter;
+    if (predicate->kind == PREDICATE_FIXED) {
+        return snprintf(buffer, size, "%c at %d", letter, predicate->pos + 1);
+    } else if (predicate->kind == PREDICATE_EXCLUDED) {
+        return snprintf(buffer, size, "no %c at %d", letter,
+                predicate->pos + 1);
+    } else if (predicate->kind == PREDICATE_WITH) {
+        return snprintf(buffer, size, "with %c", letter);
+    }
+    return snprintf(buffer, size, "without %c", letter);
+}
+
+/* static void add_predicate(PredicatePlan *plan, int kind, int pos,
+*        int letter)
+* -----------------------------------------------
+* Appends a test to a plan
+*
+* plan: the plan
+* kind: PREDICATE_FIXED, PREDICATE_EXCLUDED, PREDICATE_WITH or
+*       PREDICATE_WITHOUT
+* pos: position tested (0 for the -with/-without tests)
+* letter: letter tested, 0 for A
+*
+* Returns: -
+* Errors: -
+*/
+static void add_predicate(PredicatePlan *plan, int kind, int pos,
+        int letter)
+{
+    Predicate *predicate = &plan->predicates[plan->count++];
+    predicate->kind = kind;
+    predicate->pos = pos;
+    predicate->letter = letter;
+    predicate->passed = 0;
+}
+
+/* static int passes_predicate(const Predicate *predicate, int len,
+*        uint64_t packed, uint32_t mask)
+* -----------------------------------------------
+* Runs one test on a word
+*
+* predicate: the test
+* len: length of the word
+* packed: the packed word
+* mask: letter mask of the word
+*
+* Returns: 1 if the word passes, 0 otherwise
+* Errors: -
+*/
+static int passes_predicate(const Predicate *predicate, int len,
+        uint64_t packed, uint32_t mask)
+{
+    if (predicate->kind == PREDICATE_FIXED) {
+        return get_packed_letter(packed, len, predicate->pos)
+                == predicate->letter;
+    } else if (predicate->kind == PREDICATE_EXCLUDED) {
+        return get_packed_letter(packed, len, predicate->pos)
+                != predicate->letter;
+    } else if (predicate->kind == PREDICATE_WITH) {
+        return (mask >> predicate->letter) & 1;
+    }
+    return !((mask >> predicate->letter) & 1);
+}
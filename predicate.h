@@ -0,0 +1,51 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef PREDICATE_H
+#define PREDICATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "wordle.h"
+#include "lettermask.h"
+#include "wordindex.h"
+
+// The single-letter tests a query is made of: a letter at a position (from
+// the pattern or feedback), a letter ruled out at a position, a letter the
+// word must contain and a letter it must not contain
+#define PREDICATE_FIXED 0
+#define PREDICATE_EXCLUDED 1
+#define PREDICATE_WITH 2
+#define PREDICATE_WITHOUT 3
+#define MAX_PREDICATES (MAX_LEN * (ALPHABET_SIZE + 1) + 2 * ALPHABET_SIZE)
+// Words of the bucket the pass rate of each test is estimated on
+#define PREDICATE_SAMPLE_WORDS 256
+
+/*
+* Struct Definitions
+*/
+typedef struct {
+    uint8_t kind;
+    uint8_t pos;
+    uint8_t letter;
+    uint16_t passed;
+} Predicate;
+
+// The tests of a query in the order the filter kernels run them. Unless
+// sampleSize is 0, passed holds how many of sampleSize words sampled from
+// the bucket pass each test and the most selective tests come first.
+typedef struct {
+    int count;
+    int sampleSize;
+    Predicate predicates[MAX_PREDICATES];
+} PredicatePlan;
+
+/*
+* Function Prototypes
+*/
+void list_predicates(const WordBucket *bucket, const char *patternString,
+        const LetterRequirements *requirements, PredicatePlan *plan);
+void order_predicates(const WordBucket *bucket, PredicatePlan *plan);
+int format_predicate(const Predicate *predicate, char *buffer, size_t size);
+
+#endif
@@ -0,0 +1,1417 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#ifdef HAVE_CSSE2310A1
+#include <csse2310a1.h>
+#endif
+#include "query.h"
+#include "wordsort.h"
+#include "parallel.h"
+#include "entropy.h"
+#include "tree.h"
+#include "bitsetindex.h"
+
+#define MAX_THREADS 1024
+// -limit takes at most this many digits
+#define MAX_LIMIT_DIGITS 9
+// Room for the longest error message
+#define MAX_MESSAGE_SIZE 256
+// Pairs of words check_guess_order() names before just counting the rest
+#define MAX_REPORTED_PAIRS 10
+
+/*
+* Function Prototypes
+*/
+int is_valid_argument(char arg);
+int check_arg(char *arg);
+WordleArguments detect_len_arg(int argc, char *arg, int flag);
+WordleArguments detect_with_arg(int argc, char *arg, int withFlag);
+WordleArguments detect_without_arg(int argc, char *arg, int flag);
+WordleArguments detect_threads_arg(int argc, char *arg, int flag);
+WordleArguments detect_limit_arg(int argc, char *arg, int flag);
+WordleArguments detect_serve_arg(int argc, char *arg, int flag);
+WordleArguments detect_batch_arg(int argc, char *arg, int flag);
+WordleArguments detect_format_arg(int argc, char *arg, int flag);
+WordleArguments detect_stats_arg(int argc, char *arg, int flag);
+WordleArguments detect_feedback_arg(int argc, char *arg,
+        const FeedbackConstraints *feedback);
+WordleArguments detect_alpha_arg(int argc, char *arg, int alphaFlag,
+        int bestFlag);
+WordleArguments detect_best_arg(int argc, char *arg, int bestFlag,
+        int alphaFlag);
+WordleArguments detect_entropy_arg(int argc, char *arg, int entropyFlag);
+WordleArguments detect_session_arg(int argc, char *arg, int sessionFlag);
+WordleArguments detect_tree_arg(int argc, char *arg, int treeFlag);
+WordleArguments detect_build_tree_arg(int argc, char *arg,
+        int buildTreeFlag);
+WordleArguments detect_simulate_arg(int argc, char *arg, int simulateFlag);
+WordleArguments detect_boards_arg(int argc, char *arg, int flag);
+WordleArguments detect_pattern_arg(int argc, char *arg, int patternFlag,
+        int len);
+void set_default_len(int *lenFlag, int *len);
+int use_guess_compare(void);
+int check_guess_order(const CandidateList *candidates, int count);
+void print_words(const CandidateList *candidates, int count, OutputWriter *out);
+int replay_board_feedback(const WordleArguments *args,
+        FeedbackConstraints *boards, uint32_t *solved);
+int print_board_guesses(const WordBucket *bucket,
+        const WordleArguments *args, OutputWriter *out);
+
+/* WordleArguments parse_commandline_args(int argc, char *argv[])
+* -----------------------------------------------
+* Parses the commandline arguments that have been passed, sets flags and stores
+* parsed values. Parsing stops at the first invalid argument, with status
+* set to the exit code the program fails with.
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings, NULL
+*       terminated
+
+* Returns: A struct with all of the parsed values and flags
+* Errors: status is 1, if an argument is invalid or has been passed more
+* than once, -feedback guesses are not of the word length or do not give
+* marks for each of the -boards, -entropy is combined with -alpha or -best
+* or -tree or -boards with anything but -feedback, or 2 if the pattern is
+* invalid
+*/
+WordleArguments parse_commandline_args(int argc, char *argv[])
+{
+    WordleArguments args;
+    args.lenFlag = args.withFlag = args.withoutFlag = args.alphaFlag =
+            args.bestFlag = args.patternFlag = args.foundMatch =
+            args.threadsFlag = args.limitFlag = args.limit =
+            args.serveFlag = args.batchFlag = args.formatFlag =
+            args.statsFlag = args.statsFormat = args.feedbackFlag =
+            args.entropyFlag = args.sessionFlag = args.treeFlag =
+            args.buildTreeFlag = args.simulateFlag = args.boardsFlag =
+            args.boardFeedbackCount = args.status = 0;
+    args.format = FORMAT_LINES;
+    args.socketPath = args.batchPath = 0;
+    strcpy(args.withString, "");
+    strcpy(args.withoutString, "");
+    strcpy(args.patternString, "");
+    init_feedback_constraints(&args.feedback);
+    for (int i = 1; i < argc && !args.status; i++) {
+        if (is_valid_argument(argv[i][0])) {
+            if (check_arg(argv[i])) {
+                args.status = 1;
+                return args;
+            }
+            if (strcmp(argv[i], "-len") == 0) { // Detecting -len arg
+                WordleArguments lenStruct =
+                        detect_len_arg(argc, argv[i + 1], args.lenFlag);
+                args.len = lenStruct.len;
+                args.lenFlag = lenStruct.lenFlag;
+                args.status = lenStruct.status;
+            }
+            if (strcmp(argv[i], "-with") == 0) { // Detecting -with arg
+                WordleArguments withStruct =
+                        detect_with_arg(argc, argv[i + 1], args.withFlag);
+                args.withFlag = withStruct.withFlag;
+                strcpy(args.withString, withStruct.withString);
+                args.status = withStruct.status;
+            }
+            if (strcmp(argv[i], "-without") == 0) { // Detecting -without arg
+                WordleArguments withoutStruct =
+                        detect_without_arg(argc, argv[i + 1],
+                        args.withoutFlag);
+                args.withoutFlag = withoutStruct.withoutFlag;
+                strcpy(args.withoutString, withoutStruct.withoutString);
+                args.status = withoutStruct.status;
+            }
+            if (strcmp(argv[i], "-feedback") == 0 && argv[i + 1]
+                    && strchr(argv[i + 1], BOARD_SEPARATOR)) {
+                // Marks for several boards, checked once -boards is known
+                if (args.boardFeedbackCount == MAX_BOARD_GUESSES) {
+                    args.status = 1;
+                } else {
+                    args.boardFeedback[args.boardFeedbackCount++] =
+                            argv[i + 1];
+                }
+            } else if (strcmp(argv[i], "-feedback") == 0) {
+                WordleArguments feedbackStruct =
+                        detect_feedback_arg(argc, argv[i + 1],
+                        &args.feedback);
+                args.feedback = feedbackStruct.feedback;
+                args.feedbackFlag = feedbackStruct.feedbackFlag;
+                args.status = feedbackStruct.status;
+            }
+            if (strcmp(argv[i], "-boards") == 0) { // Detecting -boards arg
+                WordleArguments boardsStruct =
+                        detect_boards_arg(argc, argv[i + 1],
+                        args.boardsFlag);
+                args.boards = boardsStruct.boards;
+                args.boardsFlag = boardsStruct.boardsFlag;
+                args.status = boardsStruct.status;
+            }
+            if (strcmp(argv[i], "-alpha") == 0) { // Detecting -alpha arg
+                WordleArguments alphaStruct =
+                        detect_alpha_arg(argc, argv[i], args.alphaFlag,
+                        args.bestFlag);
+                args.alphaFlag = alphaStruct.alphaFlag;
+                args.status = alphaStruct.status;
+            }
+            if (strcmp(argv[i], "-best") == 0) { // Detecting -best arg
+                WordleArguments bestStruct =
+                        detect_best_arg(argc, argv[i], args.bestFlag,
+                        args.alphaFlag);
+                args.bestFlag = bestStruct.bestFlag;
+                args.status = bestStruct.status;
+            }
+            if (strcmp(argv[i], "-entropy") == 0) { // Detecting -entropy arg
+                WordleArguments entropyStruct =
+                        detect_entropy_arg(argc, argv[i], args.entropyFlag);
+                args.entropyFlag = entropyStruct.entropyFlag;
+                args.status = entropyStruct.status;
+            }
+            if (strcmp(argv[i], "-session") == 0) { // Detecting -session arg
+                WordleArguments sessionStruct =
+                        detect_session_arg(argc, argv[i], args.sessionFlag);
+                args.sessionFlag = sessionStruct.sessionFlag;
+                args.status = sessionStruct.status;
+            }
+            if (strcmp(argv[i], "-tree") == 0) { // Detecting -tree arg
+                WordleArguments treeStruct =
+                        detect_tree_arg(argc, argv[i], args.treeFlag);
+                args.treeFlag = treeStruct.treeFlag;
+                args.status = treeStruct.status;
+            }
+            if (strcmp(argv[i], "-buildtree") == 0) { // Detecting -buildtree
+                WordleArguments buildTreeStruct =
+                        detect_build_tree_arg(argc, argv[i],
+                        args.buildTreeFlag);
+                args.buildTreeFlag = buildTreeStruct.buildTreeFlag;
+                args.status = buildTreeStruct.status;
+            }
+            if (strcmp(argv[i], "-simulate") == 0) { // Detecting -simulate
+                WordleArguments simulateStruct =
+                        detect_simulate_arg(argc, argv[i],
+                        args.simulateFlag);
+                args.simulateFlag = simulateStruct.simulateFlag;
+                args.status = simulateStruct.status;
+            }
+            if (strcmp(argv[i], "-threads") == 0) { // Detecting -threads arg
+                WordleArguments threadsStruct =
+                        detect_threads_arg(argc, argv[i + 1],
+                        args.threadsFlag);
+                args.threads = threadsStruct.threads;
+                args.threadsFlag = threadsStruct.threadsFlag;
+                args.status = threadsStruct.status;
+            }
+            if (strcmp(argv[i], "-limit") == 0) { // Detecting -limit arg
+                WordleArguments limitStruct =
+                        detect_limit_arg(argc, argv[i + 1], args.limitFlag);
+                args.limit = limitStruct.limit;
+                args.limitFlag = limitStruct.limitFlag;
+                args.status = limitStruct.status;
+            }
+            if (strcmp(argv[i], "-serve") == 0) { // Detecting -serve arg
+                WordleArguments serveStruct =
+                        detect_serve_arg(argc, argv[i + 1], args.serveFlag);
+                args.socketPath = serveStruct.socketPath;
+                args.serveFlag = serveStruct.serveFlag;
+                args.status = serveStruct.status;
+                if (args.status) {
+                    break; // no path, argv[i + 1] is NULL
+                }
+                i++; // the path may start with '-'
+            }
+            if (strcmp(argv[i], "-batch") == 0) { // Detecting -batch arg
+                WordleArguments batchStruct =
+                        detect_batch_arg(argc, argv[i + 1], args.batchFlag);
+                args.batchPath = batchStruct.batchPath;
+                args.batchFlag = batchStruct.batchFlag;
+                args.status = batchStruct.status;
+                if (args.status) {
+                    break; // no path, argv[i + 1] is NULL
+                }
+                i++; // the path may be "-" for stdin
+            }
+            if (strcmp(argv[i], "-format") == 0) { // Detecting -format arg
+                WordleArguments formatStruct =
+                        detect_format_arg(argc, argv[i + 1], args.formatFlag);
+                args.format = formatStruct.format;
+                args.formatFlag = formatStruct.formatFlag;
+                args.status = formatStruct.status;
+            }
+            if (strcmp(argv[i], "-stats") == 0) { // Detecting -stats arg
+                WordleArguments statsStruct =
+                        detect_stats_arg(argc, argv[i + 1], args.statsFlag);
+                args.statsFormat = statsStruct.statsFormat;
+                args.statsFlag = statsStruct.statsFlag;
+                args.status = statsStruct.status;
+            }
+        }
+    }
+    if (args.status) {
+        return args;
+    }
+    set_default_len(&args.lenFlag, &args.len);
+    if (!args.threadsFlag) {
+        args.threads = get_default_thread_count();
+    }
+    if ((args.feedbackFlag && args.feedback.len != args.len)
+            || (args.entropyFlag && (args.alphaFlag || args.bestFlag))) {
+        args.status = 1;
+        return args;
+    }
+    if (args.boardsFlag || args.boardFeedbackCount) {
+        FeedbackConstraints boards[MAX_BOARDS];
+        uint32_t solved;
+        if (!args.boardsFlag || args.feedbackFlag || args.treeFlag
+                || args.statsFlag
+                || !replay_board_feedback(&args, boards, &solved)) {
+            args.status = 1;
+            return args;
+        }
+    }
+    // Parsing pattern
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' && (argv[i - 1][0] != '-'
+                || (strcmp(argv[i - 1], "-alpha") == 0)
+                || (strcmp(argv[i - 1], "-best") == 0)
+                || (strcmp(argv[i - 1], "-entropy") == 0)
+                || (strcmp(argv[i - 1], "-session") == 0)
+                || (strcmp(argv[i - 1], "-tree") == 0)
+                || (strcmp(argv[i - 1], "-buildtree") == 0)
+                || (strcmp(argv[i - 1], "-simulate") == 0))) {
+            WordleArguments patternStruct =
+                    detect_pattern_arg(argc, argv[i], args.patternFlag,
+                    args.len);
+            args.patternFlag = patternStruct.patternFlag;
+            strcpy(args.patternString, patternStruct.patternString);
+            args.status = patternStruct.status;
+            if (args.status) {
+                break;
+            }
+        }
+    }
+    // -tree and -boards answer from the feedback alone
+    if (!args.status && (args.treeFlag || args.boardsFlag)
+            && (args.patternFlag || args.withFlag || args.withoutFlag
+            || args.alphaFlag || args.bestFlag || args.entropyFlag)) {
+        args.status = 1;
+    }
+    return args;
+}
+
+/* WordleArguments parse_query_line(char *line)
+* -----------------------------------------------
+* Parses a query given as one line of whitespace separated command line
+* arguments, as read by -serve and -batch. Queries cannot start a server or
+* a batch or a session of their own, nor build decision trees, simulate
+* games or play several boards.
+*
+* line: the query, split up in place
+*
+* Returns: A struct with all of the parsed values and flags
+* Errors: status is set as for parse_commandline_args(), or to 1 if the line
+* uses -serve, -batch, -session, -buildtree, -simulate, -boards or -stats
+*/
+WordleArguments parse_query_line(char *line)
+{
+    // A line of n characters holds at most (n + 1) / 2 arguments
+    char **argv = malloc((strlen(line) / 2 + 3) * sizeof(char *));
+    int argc = 0;
+    char *save;
+    argv[argc++] = "wordle-helper";
+    for (char *arg = strtok_r(line, " \t\r\n", &save); arg;
+            arg = strtok_r(0, " \t\r\n", &save)) {
+        argv[argc++] = arg;
+    }
+    argv[argc] = 0;
+    WordleArguments args = parse_commandline_args(argc, argv);
+    free(argv);
+    if ((args.serveFlag || args.batchFlag || args.sessionFlag
+            || args.buildTreeFlag || args.simulateFlag || args.boardsFlag
+            || args.statsFlag) && !args.status) {
+        args.status = 1;
+    }
+    if (args.status) {
+        // The usage of a query, not of a mode it cannot start
+        args.serveFlag = args.batchFlag = args.sessionFlag =
+                args.buildTreeFlag = args.simulateFlag = args.boardsFlag = 0;
+    }
+    return args;
+}
+
+/* int format_argument_error(const WordleArguments *args, char *buffer,
+*        size_t size)
+* -----------------------------------------------
+* Formats the error message for arguments that failed to parse, without a
+* trailing newline. A usage error shows the usage of the mode the
+* arguments were for (-buildtree, -simulate, -serve, -batch, -session,
+* -boards or -tree), or else of a query.
+*
+* args: the parsed arguments, with a non-zero status
+* buffer: receives the message
+* size: size of buffer
+*
+* Returns: the length of the message
+* Errors: -
+*/
+int format_argument_error(const WordleArguments *args, char *buffer,
+        size_t size)
+{
+    if (args->status == 2) {
+        return snprintf(buffer, size,
+                "wordle-helper: pattern must be of length %d and "
+                "only contain underscores and/or letters", args->len);
+    } else if (args->buildTreeFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -buildtree "
+                "[-len len] [-threads count]");
+    } else if (args->simulateFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -simulate "
+                "[-alpha|-best|-entropy|-tree] [-len len] [-threads count]");
+    } else if (args->serveFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -serve socket "
+                "[-threads workers] [-format lines|nul|length]");
+    } else if (args->batchFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -batch file "
+                "[-threads count] [-format lines|nul|length]");
+    } else if (args->sessionFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -session "
+                "[-threads count] [-format lines|nul|length]");
+    } else if (args->boardsFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -boards count "
+                "[-len len] [-threads count] [-limit count] "
+                "[-format lines|nul|length] "
+                "[-feedback guess:marks,marks...]...");
+    } else if (args->treeFlag) {
+        return snprintf(buffer, size, "Usage: wordle-helper -tree "
+                "[-len len] [-feedback guess:marks]...");
+    } else {
+        return snprintf(buffer, size, "Usage: wordle-helper "
+                "[-alpha|-best|-entropy] [-len len] [-with letters] "
+                "[-without letters] [-threads count] [-limit count] "
+                "[-format lines|nul|length] [-stats text|json] "
+                "[-feedback guess:marks]... [pattern]");
+    }
+}
+
+/* void report_argument_error(const WordleArguments *args, FILE *stream)
+* -----------------------------------------------
+* Prints the error message for arguments that failed to parse
+*
+* args: the parsed arguments, with a non-zero status
+* stream: where the message is printed
+*
+* Returns: -
+* Errors: -
+*/
+void report_argument_error(const WordleArguments *args, FILE *stream)
+{
+    char message[MAX_MESSAGE_SIZE];
+    format_argument_error(args, message, sizeof(message));
+    fprintf(stream, "%s\n", message);
+}
+
+/* void write_answer_end(const WordleArguments *args, int status,
+*        OutputWriter *out)
+* -----------------------------------------------
+* Ends the answer to a -serve or -batch query: the error message if the
+* query failed to parse, then the exit status the command line tool would
+* have returned, each as a record of their own
+*
+* args: the parsed query
+* status: exit status of the query
+* out: where the answer is written
+*
+* Returns: -
+* Errors: -
+*/
+void write_answer_end(const WordleArguments *args, int status,
+        OutputWriter *out)
+{
+    char record[MAX_MESSAGE_SIZE];
+    if (args->status) {
+        int len = format_argument_error(args, record, sizeof(record));
+        write_record(out, record, len);
+    }
+    int len = snprintf(record, sizeof(record), "%d", status);
+    write_record(out, record, len);
+}
+
+/* int compare_with_dictionary(const WordBucket *bucket,
+*        const WordleArguments *args, ResultCache *cache, OutputWriter *out,
+*        QueryStats *stats)
+* -----------------------------------------------
+* Compares the parsed pattern, with and without characters and feedback
+* against the words from the dictionary. If a match is found, the word is
+* printed to out. With a limit, only the first limit words of the output
+* are produced: the unsorted scan stops once it has them, and -alpha/-best
+* keep just the best limit words while scanning instead of sorting every
+* match. With -entropy, every word of the bucket is printed as a guess,
+* ranked by the information it gives about the matches. -tree prints the
+* next guess of the cached decision tree instead, without scanning, and
+* -boards ranks guesses for several boards at once. Given a result cache,
+* queries printing their matches are answered from it when it holds them
+* or a looser query's matches, and their complete matches are added to it
+* otherwise; a query with a limit that misses only gets its first limit
+* words, so it is not added.
+*
+* bucket: the indexed dictionary words of the requested length, already
+*         uppercased and containing only letters
+* args: the parsed arguments
+* cache: cache of earlier results, or NULL to scan the bucket every time
+* out: where the matching words are printed
+* stats: if not NULL, receives the stage timings and filter selectivity of
+*        the query
+*
+* Returns: 0 if at least one match has been found, 4 otherwise, or
+*          TREE_ERROR_STATUS if -tree has no tree to answer from
+* Errors: -
+*/
+int compare_with_dictionary(const WordBucket *bucket,
+        const WordleArguments *args, ResultCache *cache, OutputWriter *out,
+        QueryStats *stats)
+{
+    if (args->treeFlag) {
+        return print_tree_guess(args->len,
+                args->feedbackFlag ? &args->feedback : 0, out);
+    } else if (args->boardsFlag) {
+        return print_board_guesses(bucket, args, out);
+    }
+    const char *patternString = args->patternFlag ? args->patternString : 0;
+    const char *withString = args->withFlag ? args->withString : "";
+    const char *withoutString = args->withoutFlag ? args->withoutString : "";
+    const FeedbackConstraints *feedback = args->feedbackFlag
+            ? &args->feedback : 0;
+    int sorted = args->alphaFlag || args->bestFlag;
+    CandidateList candidates;
+    int count;
+    uint64_t start = stats ? get_monotonic_ns() : 0;
+    ResultKey key;
+    int lookup = RESULT_OFF;
+    // -entropy orders are not cached
+    if (cache && !args->entropyFlag) {
+        ScanFilter filter;
+        compile_scan_filter(bucket, patternString, withString, withoutString,
+                feedback, &filter);
+        make_result_key(bucket, &filter, args->alphaFlag ? RESULT_ORDER_ALPHA
+                : args->bestFlag ? RESULT_ORDER_BEST : RESULT_ORDER_BUCKET,
+                &key);
+        lookup = find_cached_result(cache, bucket, &key, &filter,
+                &candidates);
+    }
+    int cached = lookup == RESULT_HIT || lookup == RESULT_SUBSUMED;
+    if (cached) {
+        count = candidates.count;
+    } else if (args->entropyFlag) {
+        // Every match counts towards the entropy of a guess
+        count = scan_bucket(bucket, patternString, withString, withoutString,
+                feedback, args->threads, 0, &candidates);
+    } else if (args->limit && sorted) {
+        count = select_top_candidates(bucket, patternString, withString,
+                withoutString, feedback, args->threads, args->bestFlag,
+                args->limit, &candidates);
+    } else {
+        count = scan_bucket(bucket, patternString, withString, withoutString,
+                feedback, args->threads, args->limit, &candidates);
+    }
+    uint64_t scanned = stats ? get_monotonic_ns() : 0;
+    uint64_t ordered = scanned;
+    if (count && args->entropyFlag) {
+        CandidateList guesses;
+        int guessCount = rank_guesses_by_entropy(bucket, &candidates,
+                args->threads, args->limit, &guesses);
+        ordered = stats ? get_monotonic_ns() : 0;
+        print_words(&guesses, guessCount, out);
+        free_candidates(&guesses);
+    } else if (count) {
+        if (sorted && !args->limit && !cached) {
+            // The radix sorts already drop duplicates
+            count = args->alphaFlag
+                    ? sort_candidates_alphabetically(&candidates, args->threads)
+                    : sort_candidates_by_score(&candidates, args->threads);
+            ordered = stats ? get_monotonic_ns() : 0;
+        }
+        if (args->limit && count > args->limit) {
+            count = args->limit;
+        }
+        if (args->bestFlag && use_guess_compare()) {
+            check_guess_order(&candidates, count);
+        }
+        print_words(&candidates, count, out);
+    }
+    // A limited scan stops early, but a filtered cached result is complete
+    if (lookup == RESULT_SUBSUMED || (lookup == RESULT_MISS && !args->limit)) {
+        store_cached_result(cache, &key, &candidates);
+    }
+    if (stats) {
+        stats->cacheLookup = lookup;
+        if (cache) {
+            get_result_cache_counters(cache, &stats->cacheCounters);
+        }
+        stats->scanNs = scanned - start;
+        stats->sortNs = ordered - scanned;
+        stats->outputNs = get_monotonic_ns() - ordered;
+        stats->arenaBlocks = candidates.arena.blockCount;
+        count_filter_rejections(bucket, patternString, withString,
+                withoutString, feedback, stats);
+        // The order a scan of the bucket runs the tests in
+        ScanFilter filter;
+        compile_scan_filter(bucket, patternString, withString, withoutString,
+                feedback, &filter);
+        order_scan_filter(bucket, &filter);
+        stats->predicates = filter.plan;
+    }
+    free_candidates(&candidates);
+    return count ? 0 : 4;
+}
+
+/* int print_candidates(CandidateList *candidates,
+*        const WordleArguments *args, OutputWriter *out)
+* -----------------------------------------------
+* Orders and prints every match of a query, collected in bucket order, as
+* compare_with_dictionary() would
+*
+* candidates: all the matching words, reordered in place
+* args: the parsed arguments
+* out: where the matching words are printed
+*
+* Returns: 0 if there is at least one match, 4 otherwise, or
+*          TREE_ERROR_STATUS if -tree has no tree to answer from
+* Errors: -
+*/
+int print_candidates(CandidateList *candidates, const WordleArguments *args,
+        OutputWriter *out)
+{
+    if (args->treeFlag) {
+        return print_tree_guess(args->len,
+                args->feedbackFlag ? &args->feedback : 0, out);
+    } else if (candidates->count == 0) {
+        return 4;
+    }
+    if (args->entropyFlag) {
+        CandidateList guesses;
+        int count = rank_guesses_by_entropy(candidates->bucket, candidates,
+                args->threads, args->limit, &guesses);
+        print_words(&guesses, count, out);
+        free_candidates(&guesses);
+        return 0;
+    }
+    int count = candidates->count;
+    if (args->alphaFlag) {
+        count = sort_candidates_alphabetically(candidates, args->threads);
+    } else if (args->bestFlag) {
+        count = sort_candidates_by_score(candidates, args->threads);
+    }
+    if (args->limit && count > args->limit) {
+        count = args->limit;
+    }
+    if (args->bestFlag && use_guess_compare()) {
+        check_guess_order(candidates, count);
+    }
+    print_words(candidates, count, out);
+    return 0;
+}
+
+/* int use_guess_compare(void)
+* -----------------------------------------------
+* Checks whether the -best order should be checked against the course
+* library's guess_compare() (see check_guess_order()). This compatibility
+* mode is only available when the program is built against the library
+* (make GUESS_COMPARE=1), and is turned on by setting WORDLE_GUESS_COMPARE.
+*
+* Returns: 1 if the order should be checked, 0 otherwise
+* Errors: -
+*/
+int use_guess_compare(void)
+{
+#ifdef HAVE_CSSE2310A1
+    return getenv("WORDLE_GUESS_COMPARE") != 0;
+#else
+    return 0;
+#endif
+}
+
+/* int check_guess_order(const CandidateList *candidates, int count)
+* -----------------------------------------------
+* Checks the -best order of the words about to be printed, ranked by the
+* built-in letter frequency scores, against guess_compare(): each word must
+* rank at least as high as the next one, and words it ranks the same must
+* be in alphabetical order. The first MAX_REPORTED_PAIRS pairs of
+* neighbouring words it would have put the other way round are reported on
+* stderr, followed by how many pairs there are in all; the words are
+* printed in the built-in order regardless.
+*
+* candidates: the words in -best order
+* count: number of words that are printed
+*
+* Returns: the number of pairs guess_compare() disagrees with
+* Errors: -
+*/
+int check_guess_order(const CandidateList *candidates, int count)
+{
+    int disagreements = 0;
+#ifdef HAVE_CSSE2310A1
+    for (int i = 1; i < count; i++) {
+        const char *before = get_candidate_word(candidates, i - 1);
+        const char *after = get_candidate_word(candidates, i);
+        int compared = guess_compare(before, after);
+        if (compared < 0 || (compared == 0 && strcmp(before, after) > 0)) {
+            if (disagreements++ < MAX_REPORTED_PAIRS) {
+                fprintf(stderr, "wordle-helper: guess_compare() ranks %s "
+                        "above %s\n", after, before);
+            }
+        }
+    }
+    if (disagreements) {
+        fprintf(stderr, "wordle-helper: guess_compare() disagrees with %d "
+                "of %d pairs of the -best order\n", disagreements,
+                count - 1);
+    }
+#else
+    (void) candidates;
+    (void) count;
+#endif
+    return disagreements;
+}
+
+/* void print_words(const CandidateList *candidates, int count, OutputWriter *out)
+* -----------------------------------------------
+* Prints the first count words of a candidate list
+*
+* candidates: the words that are to be printed
+* count: number of words to print
+* out: where the words are printed
+*
+* Returns: -
+* Errors: -
+*/
+void print_words(const CandidateList *candidates, int count, OutputWriter *out)
+{
+    int len = candidates->bucket->len;
+    for (int i = 0; i < count; i++) {
+        write_word(out, get_candidate_word(candidates, i), len);
+    }
+}
+
+/* int replay_board_feedback(const WordleArguments *args,
+*        FeedbackConstraints *boards, uint32_t *solved)
+* -----------------------------------------------
+* Works out the constraints of each of the -boards from the multi-board
+* -feedback arguments
+*
+* args: the parsed arguments, with boards set
+* boards: receives the constraints of each board
+* solved: receives a bitmap of the boards already solved
+*
+* Returns: 1 if every -feedback argument is valid for the number of boards
+*          and the word length, 0 otherwise
+* Errors: -
+*/
+int replay_board_feedback(const WordleArguments *args,
+        FeedbackConstraints *boards, uint32_t *solved)
+{
+    *solved = 0;
+    for (int board = 0; board < args->boards; board++) {
+        init_feedback_constraints(&boards[board]);
+    }
+    for (int i = 0; i < args->boardFeedbackCount; i++) {
+        const char *arg = args->boardFeedback[i];
+        const char *separator = strchr(arg, ':');
+        if (separator == 0 || separator - arg != args->len
+                || !add_board_feedback(boards, args->boards, solved, arg)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* int print_board_guesses(const WordBucket *bucket,
+*        const WordleArguments *args, OutputWriter *out)
+* -----------------------------------------------
+* Prints every word of the bucket as a guess for the boards that are not
+* solved yet, best first (see rank_guesses_across_boards()). The
+* candidates of all of those boards are found in one pass over the bucket.
+*
+* bucket: the words of the requested length
+* args: the parsed arguments, with boards set
+* out: where the guesses are printed
+*
+* Returns: 0 if guesses were printed, 4 if every board is solved or a
+*          board has no candidates left
+* Errors: -
+*/
+int print_board_guesses(const WordBucket *bucket,
+        const WordleArguments *args, OutputWriter *out)
+{
+    FeedbackConstraints boards[MAX_BOARDS];
+    ScanFilter filters[MAX_BOARDS];
+    uint64_t *results[MAX_BOARDS];
+    CandidateList candidates[MAX_BOARDS];
+    uint32_t solved;
+    replay_board_feedback(args, boards, &solved);
+    int boardCount = 0;
+    for (int board = 0; board < args->boards; board++) {
+        if (!(solved & (1u << board))) {
+            compile_scan_filter(bucket, 0, "", "", &boards[board],
+                    &filters[boardCount]);
+            order_scan_filter(bucket, &filters[boardCount++]);
+        }
+    }
+    if (boardCount == 0) {
+        return 4;
+    }
+    size_t blocks = get_bitset_words(bucket->count);
+    uint64_t *matches = malloc(boardCount * blocks * sizeof(uint64_t));
+    for (int i = 0; i < boardCount; i++) {
+        results[i] = matches + i * blocks;
+    }
+    filter_bucket_group(bucket, filters, boardCount, args->threads, results);
+    for (int i = 0; i < boardCount; i++) {
+        collect_candidates(bucket, &filters[i], results[i], &candidates[i]);
+    }
+    free(matches);
+    CandidateList guesses;
+    int count = rank_guesses_across_boards(bucket, candidates, boardCount,
+            args->threads, args->limit, &guesses);
+    print_words(&guesses, count, out);
+    free_candidates(&guesses);
+    for (int i = 0; i < boardCount; i++) {
+        free_candidates(&candidates[i]);
+    }
+    return count ? 0 : 4;
+}
+
+/* int check_arg(char *arg)
+* -----------------------------------------------
+* Checks if the argument that is being parsed is a valid argument or not
+*
+* arg: the argument that needs to be checked
+*
+* Returns: 1, if the argument is not a valid argument
+           0, if the argument is a valid argument
+* Errors: -
+*/
+int check_arg(char *arg) {
+    if ((strcmp(arg, "-len") != 0)
+            && (strcmp(arg, "-alpha") != 0)
+            && (strcmp(arg, "-best") != 0)
+            && (strcmp(arg, "-with") != 0)
+            && (strcmp(arg, "-without") != 0)
+            && (strcmp(arg, "-threads") != 0)
+            && (strcmp(arg, "-limit") != 0)
+            && (strcmp(arg, "-serve") != 0)
+            && (strcmp(arg, "-batch") != 0)
+            && (strcmp(arg, "-format") != 0)
+            && (strcmp(arg, "-stats") != 0)
+            && (strcmp(arg, "-feedback") != 0)
+            && (strcmp(arg, "-entropy") != 0)
+            && (strcmp(arg, "-session") != 0)
+            && (strcmp(arg, "-tree") != 0)
+            && (strcmp(arg, "-buildtree") != 0)
+            && (strcmp(arg, "-simulate") != 0)
+            && (strcmp(arg, "-boards") != 0)) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/* int is_valid_argument(char arg)
+* -----------------------------------------------
+* Checks if the input argument is valid or not.
+*
+* arg: commandline argument
+* Returns: 1: if valid, 0: if invalid
+* Errors: -
+*/
+int is_valid_argument(char arg)
+{
+    if (arg == '-') {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/* WordleArguments detect_len_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -len argument and parses the length value.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -len argument has been detected,
+        0: indicates that -len argument has not been detected.
+* Returns: a struct with the updated values of len & lenFlag.
+* Errors: status is 1, if the argument count < 3 or
+*           if the length value is missing or not a number or
+            if the length value is < MIN_LEN or > MAX_LEN
+*/
+WordleArguments detect_len_arg(int argc, char *arg, int flag)
+{
+    WordleArguments l;
+    l.status = 0;
+    if (!flag) {
+        if (argc < 3 || arg == 0) {
+            l.status = 1;
+            return l;
+        }
+        if (strlen(arg) != 1) {
+            l.status = 1;
+            return l;
+        }
+        l.len = atoi(arg);
+        l.lenFlag = 1;
+        if ((l.len > MAX_LEN || l.len < MIN_LEN)) {
+            l.status = 1;
+        }
+    } else {
+        l.status = 1;
+    }
+    return l;
+}
+
+/* WordleArguments detect_with_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -with argument and parses the with string.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -with argument has been detected,
+        0: indicates that -with argument has not been detected.
+* Returns: a struct with the updated values of withString & withFlag.
+* Errors: status is 1, if the supplied string contains
+          non-alphabet characters, is too long or is null
+*/
+WordleArguments detect_with_arg(int argc, char *arg, int flag)
+{
+    WordleArguments w;
+    w.status = 0;
+    strcpy(w.withString, "");
+    if (!flag) {
+        if (arg == 0) {
+            w.status = 1;
+            return w;
+        }
+        if (strlen(arg) <= 0 || strlen(arg) >= MAX_WORD_SIZE) {
+            w.status = 1;
+            return w;
+        }
+        for (int i = 0; arg[i]; i++) {
+            if (isalpha(arg[i]) == 0) {
+                w.status = 1;
+                return w;
+            }
+        }
+        strcpy(w.withString, arg);
+        for (int j = 0; w.withString[j]; j++) {
+            w.withString[j] = toupper(w.withString[j]);
+        }
+        w.withFlag = 1;
+    } else {
+        w.status = 1;
+    }
+    return w;
+}
+
+/* WordleArguments detect_without_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -without argument and parses the without string.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -without argument has been detected,
+        0: indicates that -without argument has not been detected.
+* Returns: a struct with the updated values of withoutString & withoutFlag.
+* Errors: status is 1, if the supplied string contains
+          non-alphabet characters, is too long or is null
+*/
+WordleArguments detect_without_arg(int argc, char *arg, int flag)
+{
+    WordleArguments wo;
+    wo.status = 0;
+    strcpy(wo.withoutString, "");
+    if (!flag) {
+        if (arg == 0) {
+            wo.status = 1;
+            return wo;
+        }
+        if (strlen(arg) <= 0 || strlen(arg) >= MAX_WORD_SIZE) {
+            wo.status = 1;
+            return wo;
+        }
+        for (int i = 0; arg[i]; i++) {
+            if (isalpha(arg[i]) == 0) {
+                wo.status = 1;
+                return wo;
+            }
+        }
+        strcpy(wo.withoutString, arg);
+        for (int j = 0; wo.withoutString[j]; j++) {
+            wo.withoutString[j] = toupper(wo.withoutString[j]);
+        }
+        wo.withoutFlag = 1;
+    } else {
+        wo.status = 1;
+    }
+    return wo;
+}
+
+/* WordleArguments detect_threads_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -threads argument and parses the thread count.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -threads argument has been detected,
+        0: indicates that -threads argument has not been detected.
+* Returns: a struct with the updated values of threads & threadsFlag.
+* Errors: status is 1, if the thread count is missing, is not a
+          number or is not between 1 and MAX_THREADS
+*/
+WordleArguments detect_threads_arg(int argc, char *arg, int flag)
+{
+    WordleArguments t;
+    t.status = 0;
+    if (flag || arg == 0 || strlen(arg) <= 0 || strlen(arg) > 4) {
+        t.status = 1;
+        return t;
+    }
+    for (int i = 0; arg[i]; i++) {
+        if (isdigit(arg[i]) == 0) {
+            t.status = 1;
+            return t;
+        }
+    }
+    t.threads = atoi(arg);
+    if (t.threads < 1 || t.threads > MAX_THREADS) {
+        t.status = 1;
+    }
+    t.threadsFlag = 1;
+    return t;
+}
+
+/* WordleArguments detect_limit_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -limit argument and parses the word limit.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -limit argument has been detected,
+        0: indicates that -limit argument has not been detected.
+* Returns: a struct with the updated values of limit & limitFlag.
+* Errors: status is 1, if the limit is missing, is not a number or is
+          not greater than 0
+*/
+WordleArguments detect_limit_arg(int argc, char *arg, int flag)
+{
+    WordleArguments l;
+    l.status = 0;
+    if (flag || arg == 0 || strlen(arg) <= 0
+            || strlen(arg) > MAX_LIMIT_DIGITS) {
+        l.status = 1;
+        return l;
+    }
+    for (int i = 0; arg[i]; i++) {
+        if (isdigit(arg[i]) == 0) {
+            l.status = 1;
+            return l;
+        }
+    }
+    l.limit = atoi(arg);
+    if (l.limit < 1) {
+        l.status = 1;
+    }
+    l.limitFlag = 1;
+    return l;
+}
+
+/* WordleArguments detect_serve_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -serve argument and records the socket path.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -serve argument has been detected,
+        0: indicates that -serve argument has not been detected.
+* Returns: a struct with the updated values of socketPath & serveFlag.
+* Errors: status is 1, if the socket path is missing or empty
+*/
+WordleArguments detect_serve_arg(int argc, char *arg, int flag)
+{
+    WordleArguments s;
+    s.status = 0;
+    s.socketPath = arg;
+    if (flag || arg == 0 || strlen(arg) <= 0) {
+        s.status = 1;
+    }
+    s.serveFlag = 1;
+    return s;
+}
+
+/* WordleArguments detect_batch_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -batch argument and records the batch file path.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -batch argument has been detected,
+        0: indicates that -batch argument has not been detected.
+* Returns: a struct with the updated values of batchPath & batchFlag.
+* Errors: status is 1, if the batch file path is missing or empty
+*/
+WordleArguments detect_batch_arg(int argc, char *arg, int flag)
+{
+    WordleArguments b;
+    b.status = 0;
+    b.batchPath = arg;
+    if (flag || arg == 0 || strlen(arg) <= 0) {
+        b.status = 1;
+    }
+    b.batchFlag = 1;
+    return b;
+}
+
+/* WordleArguments detect_format_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -format argument and parses the output format.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -format argument has been detected,
+        0: indicates that -format argument has not been detected.
+* Returns: a struct with the updated values of format & formatFlag.
+* Errors: status is 1, if the format is missing or is not one of "lines",
+          "nul" or "length"
+*/
+WordleArguments detect_format_arg(int argc, char *arg, int flag)
+{
+    WordleArguments f;
+    f.status = 0;
+    f.format = FORMAT_LINES;
+    if (flag || arg == 0) {
+        f.status = 1;
+    } else if (strcmp(arg, "nul") == 0) {
+        f.format = FORMAT_NUL;
+    } else if (strcmp(arg, "length") == 0) {
+        f.format = FORMAT_LENGTH;
+    } else if (strcmp(arg, "lines") != 0) {
+        f.status = 1;
+    }
+    f.formatFlag = 1;
+    return f;
+}
+
+/* WordleArguments detect_stats_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -stats argument and parses the statistics format.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -stats argument has been detected,
+        0: indicates that -stats argument has not been detected.
+* Returns: a struct with the updated values of statsFormat & statsFlag.
+* Errors: status is 1, if the format is missing or is not "text" or "json"
+*/
+WordleArguments detect_stats_arg(int argc, char *arg, int flag)
+{
+    WordleArguments s;
+    s.status = 0;
+    s.statsFormat = STATS_TEXT;
+    if (flag || arg == 0) {
+        s.status = 1;
+    } else if (strcmp(arg, "json") == 0) {
+        s.statsFormat = STATS_JSON;
+    } else if (strcmp(arg, "text") != 0) {
+        s.status = 1;
+    }
+    s.statsFlag = 1;
+    return s;
+}
+
+/* WordleArguments detect_feedback_arg(int argc, char *arg,
+*        const FeedbackConstraints *feedback)
+* -----------------------------------------------
+* Checks validity of a -feedback argument and adds it to the feedback given
+* so far. Unlike the other arguments, -feedback may be given once per guess.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* feedback: the feedback of the earlier -feedback arguments
+* Returns: a struct with the updated values of feedback & feedbackFlag.
+* Errors: status is 1, if the feedback is missing, is not a guess and its
+          G/Y/B marks, or its guess length differs from earlier guesses
+*/
+WordleArguments detect_feedback_arg(int argc, char *arg,
+        const FeedbackConstraints *feedback)
+{
+    WordleArguments f;
+    f.status = 0;
+    f.feedback = *feedback;
+    if (arg == 0 || !add_feedback(&f.feedback, arg)) {
+        f.status = 1;
+    }
+    f.feedbackFlag = 1;
+    return f;
+}
+
+/* WordleArguments detect_alpha_arg(int argc, char *arg, int alphaFlag,
+*        int bestFlag)
+* -----------------------------------------------
+* Checks validity of -alpha argument and sets the alphaFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -alpha argument has been detected,
+        0: indicates that -alpha argument has not been detected.
+* Returns: a struct with the updated values of alphaFlag.
+* Errors: status is 1, if the -best arg has been supplied along with the
+          -alpha arg or if the -alpha arg has been supplied more than once
+*/
+WordleArguments detect_alpha_arg(int argc, char *arg, int alphaFlag,
+        int bestFlag)
+{
+    WordleArguments a;
+    a.status = 0;
+    if (alphaFlag == 1) {
+        a.status = 1;
+    }
+    if (bestFlag == 1) {
+        a.status = 1;
+    }
+    a.alphaFlag = 1;
+    return a;
+}
+
+/* WordleArguments detect_best_arg(int argc, char *arg, int bestFlag,
+*        int alphaFlag)
+* -----------------------------------------------
+* Checks validity of -best argument and sets the bestFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -best argument has been detected,
+        0: indicates that -best argument has not been detected.
+* Returns: a struct with the updated values of bestFlag.
+* Errors: status is 1, if the -best arg has been supplied along with the
+          -alpha arg or if the -best arg has been supplied more than once
+*/
+WordleArguments detect_best_arg(int argc, char *arg,
+        int bestFlag, int alphaFlag)
+{
+    WordleArguments b;
+    b.status = 0;
+    if (bestFlag == 1) {
+        b.status = 1;
+    }
+    if (alphaFlag == 1) {
+        b.status = 1;
+    }
+    b.bestFlag = 1;
+    return b;
+}
+
+/* WordleArguments detect_entropy_arg(int argc, char *arg, int entropyFlag)
+* -----------------------------------------------
+* Checks validity of -entropy argument and sets the entropyFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -entropy argument has been detected,
+        0: indicates that -entropy argument has not been detected.
+* Returns: a struct with the updated values of entropyFlag.
+* Errors: status is 1, if the -entropy arg has been supplied more than once
+*/
+WordleArguments detect_entropy_arg(int argc, char *arg, int entropyFlag)
+{
+    WordleArguments e;
+    e.status = 0;
+    if (entropyFlag == 1) {
+        e.status = 1;
+    }
+    e.entropyFlag = 1;
+    return e;
+}
+
+/* WordleArguments detect_session_arg(int argc, char *arg, int sessionFlag)
+* -----------------------------------------------
+* Checks validity of -session argument and sets the sessionFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -session argument has been detected,
+        0: indicates that -session argument has not been detected.
+* Returns: a struct with the updated values of sessionFlag.
+* Errors: status is 1, if the -session arg has been supplied more than once
+*/
+WordleArguments detect_session_arg(int argc, char *arg, int sessionFlag)
+{
+    WordleArguments s;
+    s.status = 0;
+    if (sessionFlag == 1) {
+        s.status = 1;
+    }
+    s.sessionFlag = 1;
+    return s;
+}
+
+/* WordleArguments detect_tree_arg(int argc, char *arg, int treeFlag)
+* -----------------------------------------------
+* Checks validity of -tree argument and sets the treeFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -tree argument has been detected,
+        0: indicates that -tree argument has not been detected.
+* Returns: a struct with the updated values of treeFlag.
+* Errors: status is 1, if the -tree arg has been supplied more than once
+*/
+WordleArguments detect_tree_arg(int argc, char *arg, int treeFlag)
+{
+    WordleArguments t;
+    t.status = 0;
+    if (treeFlag == 1) {
+        t.status = 1;
+    }
+    t.treeFlag = 1;
+    return t;
+}
+
+/* WordleArguments detect_build_tree_arg(int argc, char *arg,
+*        int buildTreeFlag)
+* -----------------------------------------------
+* Checks validity of -buildtree argument and sets the buildTreeFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -buildtree argument has been detected,
+        0: indicates that -buildtree argument has not been detected.
+* Returns: a struct with the updated values of buildTreeFlag.
+* Errors: status is 1, if the -buildtree arg has been supplied more than
+*         once
+*/
+WordleArguments detect_build_tree_arg(int argc, char *arg,
+        int buildTreeFlag)
+{
+    WordleArguments b;
+    b.status = 0;
+    if (buildTreeFlag == 1) {
+        b.status = 1;
+    }
+    b.buildTreeFlag = 1;
+    return b;
+}
+
+/* WordleArguments detect_simulate_arg(int argc, char *arg,
+*        int simulateFlag)
+* -----------------------------------------------
+* Checks validity of -simulate argument and sets the simulateFlag.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -simulate argument has been detected,
+        0: indicates that -simulate argument has not been detected.
+* Returns: a struct with the updated values of simulateFlag.
+* Errors: status is 1, if the -simulate arg has been supplied more than
+*         once
+*/
+WordleArguments detect_simulate_arg(int argc, char *arg, int simulateFlag)
+{
+    WordleArguments s;
+    s.status = 0;
+    if (simulateFlag == 1) {
+        s.status = 1;
+    }
+    s.simulateFlag = 1;
+    return s;
+}
+
+/* WordleArguments detect_boards_arg(int argc, char *arg, int flag)
+* -----------------------------------------------
+* Checks validity of -boards argument and parses the number of boards.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that -boards argument has been detected,
+        0: indicates that -boards argument has not been detected.
+* Returns: a struct with the updated values of boards & boardsFlag.
+* Errors: status is 1, if the count is missing, is not a number or is not
+          between 2 and MAX_BOARDS
+*/
+WordleArguments detect_boards_arg(int argc, char *arg, int flag)
+{
+    WordleArguments b;
+    b.status = b.boards = 0;
+    b.boardsFlag = 1;
+    if (flag || arg == 0 || strlen(arg) <= 0 || strlen(arg) > 2) {
+        b.status = 1;
+        return b;
+    }
+    for (int i = 0; arg[i]; i++) {
+        if (isdigit(arg[i]) == 0) {
+            b.status = 1;
+            return b;
+        }
+    }
+    b.boards = atoi(arg);
+    if (b.boards < 2 || b.boards > MAX_BOARDS) {
+        b.status = 1;
+    }
+    return b;
+}
+
+/* WordleArguments detect_pattern_arg(int argc, char *arg, int patternFlag,
+*        int len)
+* -----------------------------------------------
+* Checks validity of the supplied pattern and parses the pattern.
+*
+* argc: count of commandline arguments.
+* arg: the current commandline argument that is being checked.
+* flag: 1: indicates that a pattern string argument has been detected,
+        0: indicates that a pattern string argument has not been detected.
+* Returns: a struct with the updated values of patternFlag & patternString.
+* Errors: status is 2, if the supplied pattern is not as long as
+*         the -len value or has characters other than letters and
+*         underscores, or 1 if a pattern has been supplied more than once
+*/
+WordleArguments detect_pattern_arg(int argc, char *arg, int flag, int len)
+{
+    WordleArguments p;
+    p.status = 0;
+    strcpy(p.patternString, "");
+    if (flag == 1) {
+        p.status = 1;
+        return p;
+    }
+    for (int i = 0; arg[i]; i++) {
+        if (isalpha(arg[i]) == 0 && arg[i] != '_') {
+            p.status = 2;
+            return p;
+        }
+    }
+    if (strlen(arg) != len) {
+        p.status = 2;
+        return p;
+    }
+    strcpy(p.patternString, arg);
+    for (int j = 0; p.patternString[j]; j++) {
+        p.patternString[j] = toupper(p.patternString[j]);
+    }
+    p.patternFlag = 1;
+    return p;
+}
+
+/* void set_default_len(int *lenFlag, int *len)
+* -----------------------------------------------
+* If length is not specified, sets length to the DEFAULT_LEN value
+*
+* lenFlag: flag that indicates if length has been specified or not
+* len: length that is set to DEFAULT_LEN value
+*
+* Returns:-
+* Errors: -
+*/
+void set_default_len(int *lenFlag, int *len)
+{
+    if (*lenFlag == 0) {
+        *len = DEFAULT_LEN;
+    }
+}
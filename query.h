@@ -0,0 +1,53 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <stdio.h>
+#include "wordle.h"
+#include "wordindex.h"
+#include "scan.h"
+#include "output.h"
+#include "stats.h"
+#include "resultcache.h"
+
+/*
+* Struct Definition
+*/
+// A parsed query. status is the exit code the query fails with (1 usage,
+// 2 bad pattern) or 0 if it parsed cleanly.
+typedef struct {
+    int len, threads, limit, format, statsFormat, boards;
+    int lenFlag, withFlag, withoutFlag, alphaFlag, bestFlag, patternFlag,
+            foundMatch, threadsFlag, limitFlag, serveFlag, batchFlag,
+            formatFlag, statsFlag, feedbackFlag, entropyFlag, sessionFlag,
+            treeFlag, buildTreeFlag, simulateFlag, boardsFlag;
+    char withString[MAX_WORD_SIZE], withoutString[MAX_WORD_SIZE],
+            patternString[MAX_SIZE];
+    FeedbackConstraints feedback;
+    // -feedback arguments with marks for several boards, as given
+    const char *boardFeedback[MAX_BOARD_GUESSES];
+    int boardFeedbackCount;
+    const char *socketPath;
+    const char *batchPath;
+    int status;
+} WordleArguments;
+
+/*
+* Function Prototypes
+*/
+WordleArguments parse_commandline_args(int argc, char *argv[]);
+WordleArguments parse_query_line(char *line);
+int format_argument_error(const WordleArguments *args, char *buffer,
+        size_t size);
+void report_argument_error(const WordleArguments *args, FILE *stream);
+int compare_with_dictionary(const WordBucket *bucket,
+        const WordleArguments *args, ResultCache *cache, OutputWriter *out,
+        QueryStats *stats);
+int print_candidates(CandidateList *candidates, const WordleArguments *args,
+        OutputWriter *out);
+void write_answer_end(const WordleArguments *args, int status,
+        OutputWriter *out);
+
+#endif
@@ -0,0 +1,665 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include "resultcache.h"
+#include "dictionary.h"
+#include "wordsort.h"
+
+// The cache keeps the complete, ordered list of matches of each query it is
+// given. A query that is not in the cache can still be answered from the
+// result of a looser query that matches every word it matches (one that
+// subsumes it), by filtering that smaller list instead of the bucket. The
+// smallest such result is used, and reordered if it was cached in another
+// order. -best orders by letter statistics of the matches themselves, so
+// its results are always ranked afresh after filtering. The filtered
+// result is cached in turn, so a run of refinements keeps finding a tight
+// result to start from.
+
+// Checking a cached word ID reads that word's part of the index, often
+// faulting its pages in for the first time, and costs about as much as a
+// bitset scan of a few hundred words. A looser result is only filtered if
+// it holds at most this fraction of the bucket.
+#define MAX_SUBSUMED_FRACTION 256
+
+// Cached results on disk: a header, then every entry as its key, the time
+// it was last used and its word IDs. The header records the size and
+// modification time of the dictionary the results were worked out for.
+#define RESULT_CACHE_MAGIC "WHRC"
+#define RESULT_CACHE_VERSION 3
+
+/*
+* Struct Definitions
+*/
+struct ResultEntry {
+    ResultKey key;
+    uint64_t lastUsed;
+    uint32_t count;
+    uint32_t *ids;
+};
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t len;
+    uint32_t count;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    int64_t sourceMtimeNsec;
+    uint64_t entryCount;
+    uint64_t hits;
+    uint64_t subsumedHits;
+    uint64_t misses;
+    uint64_t evictions;
+} ResultCacheHeader;
+
+typedef struct {
+    ResultKey key;
+    uint64_t lastUsed;
+    uint32_t count;
+    uint32_t reserved;
+} StoredEntry;
+
+// What write_results_file() writes
+typedef struct {
+    const ResultCacheHeader *header;
+    const ResultCache *cache;
+} ResultsFile;
+
+/*
+* Function Prototypes
+*/
+static int subsumes(const ResultKey *loose, const ResultKey *tight);
+static void order_cached_result(const WordBucket *bucket, int order,
+        CandidateList *candidates);
+static void add_entry(ResultCache *cache, const ResultKey *key,
+        const uint32_t *ids, uint32_t count, uint64_t lastUsed);
+static void evict_least_recent(ResultCache *cache);
+static size_t get_entry_size(uint32_t count);
+static int get_result_cache_path(const WordBucket *bucket, char *path,
+        size_t size);
+static int fill_cache_header(const ResultCache *cache,
+        const WordBucket *bucket, ResultCacheHeader *header);
+static int write_results_file(FILE *file, const void *context);
+
+/* size_t get_result_cache_limit(size_t defaultMb)
+* -----------------------------------------------
+* Works out how large the result cache may grow, from
+* WORDLE_RESULT_CACHE_MB if it is set
+*
+* defaultMb: size in MB when WORDLE_RESULT_CACHE_MB is not set
+*
+* Returns: the size in bytes, 0 if there should be no cache
+* Errors: -
+*/
+size_t get_result_cache_limit(size_t defaultMb)
+{
+    const char *env = getenv("WORDLE_RESULT_CACHE_MB");
+    long mb = env ? atol(env) : (long) defaultMb;
+    return mb > 0 ? (size_t) mb * 1024 * 1024 : 0;
+}
+
+/* void init_result_cache(ResultCache *cache, size_t maxBytes)
+* -----------------------------------------------
+* Sets up an empty result cache
+*
+* cache: the cache
+* maxBytes: how much memory the cached results may take up
+*
+* Returns: -
+* Errors: -
+*/
+void init_result_cache(ResultCache *cache, size_t maxBytes)
+{
+    memset(cache, 0, sizeof(*cache));
+    pthread_mutex_init(&cache->lock, 0);
+    cache->maxBytes = maxBytes;
+}
+
+/* void free_result_cache(ResultCache *cache)
+* -----------------------------------------------
+* Releases every cached result
+*
+* cache: the cache
+*
+* Returns: -
+* Errors: -
+*/
+void free_result_cache(ResultCache *cache)
+{
+    for (int i = 0; i < cache->entryCount; i++) {
+        free(cache->entries[i].ids);
+    }
+    free(cache->entries);
+    pthread_mutex_destroy(&cache->lock);
+}
+
+/* void make_result_key(const WordBucket *bucket, const ScanFilter *filter,
+*        int order, ResultKey *key)
+* -----------------------------------------------
+* Puts a compiled query into canonical form. Letters a position is fixed to
+* count towards the lower bounds, letters that cannot occur at all are not
+* repeated in excludedAt and a fixed position rules out nothing more. A
+* query whose constraints contradict each other gets the impossible key.
+*
+* bucket: the bucket the query is for
+* filter: the compiled query
+* order: RESULT_ORDER_BUCKET, RESULT_ORDER_ALPHA or RESULT_ORDER_BEST
+* key: receives the key
+*
+* Returns: -
+* Errors: -
+*/
+void make_result_key(const WordBucket *bucket, const ScanFilter *filter,
+        int order, ResultKey *key)
+{
+    const LetterRequirements *requirements = &filter->requirements;
+    int len = bucket->len;
+    memset(key, 0, sizeof(*key));
+    key->len = len;
+    key->order = order;
+    key->fixedMask = filter->fixedMask;
+    key->fixedLetters = filter->fixedLetters;
+    uint8_t fixedCounts[ALPHABET_SIZE];
+    memset(fixedCounts, 0, sizeof(fixedCounts));
+    for (int pos = 0; pos < len; pos++) {
+        if (get_packed_letter(filter->fixedMask, len, pos)) {
+            fixedCounts[get_packed_letter(filter->fixedLetters, len,
+                    pos)]++;
+        }
+    }
+    uint32_t absent = 0;
+    int impossible = filter->impossible;
+    int minTotal = 0;
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        uint8_t minCount = requirements->withExact[letter];
+        key->minCounts[letter] = minCount > fixedCounts[letter]
+                ? minCount : fixedCounts[letter];
+        key->maxCounts[letter] = requirements->withoutMask & (1u << letter)
+                ? 0 : requirements->maxExact[letter];
+        if (key->maxCounts[letter] == 0) {
+            absent |= 1u << letter;
+        }
+        impossible |= key->minCounts[letter] > key->maxCounts[letter];
+        minTotal += key->minCounts[letter];
+    }
+    impossible |= minTotal > len;
+    for (int pos = 0; pos < len; pos++) {
+        uint32_t ruledOut = requirements->excludedAt[pos] | absent;
+        if (get_packed_letter(filter->fixedMask, len, pos)) {
+            int letter = get_packed_letter(filter->fixedLetters, len, pos);
+            impossible |= (ruledOut & (1u << letter)) != 0;
+            key->excludedAt[pos] = 0;
+        } else {
+            impossible |= ruledOut == ALL_LETTERS;
+            key->excludedAt[pos] = ruledOut & ~absent;
+        }
+    }
+    if (impossible) {
+        memset(key, 0, sizeof(*key));
+        key->len = len;
+        key->order = order;
+        key->impossible = 1;
+    }
+}
+
+/* int find_cached_result(ResultCache *cache, const WordBucket *bucket,
+*        const ResultKey *key, const ScanFilter *filter,
+*        CandidateList *candidates)
+* -----------------------------------------------
+* Looks a query up in the cache: its own result if it is cached, otherwise
+* the smallest cached result of a query subsuming it, filtered down to the
+* words the query matches and put in the query's order. Results too large
+* to filter faster than the bucket can be scanned are passed over.
+*
+* cache: the cache
+* bucket: the bucket the query is for
+* key: the query's key
+* filter: the compiled query
+* candidates: receives every match, in the key's order, when the result
+*             is RESULT_HIT or RESULT_SUBSUMED; release with
+*             free_candidates()
+*
+* Returns: RESULT_HIT, RESULT_SUBSUMED or RESULT_MISS
+* Errors: -
+*/
+int find_cached_result(ResultCache *cache, const WordBucket *bucket,
+        const ResultKey *key, const ScanFilter *filter,
+        CandidateList *candidates)
+{
+    pthread_mutex_lock(&cache->lock);
+    ResultEntry *found = 0;
+    int exact = 0;
+    uint32_t maxSubsumed = bucket->count / MAX_SUBSUMED_FRACTION;
+    for (int i = 0; i < cache->entryCount && !exact; i++) {
+        ResultEntry *entry = &cache->entries[i];
+        if (memcmp(&entry->key, key, sizeof(*key)) == 0) {
+            found = entry;
+            exact = 1;
+        } else if (entry->count <= maxSubsumed
+                && (found == 0 || entry->count < found->count)
+                && subsumes(&entry->key, key)) {
+            found = entry;
+        }
+    }
+    if (found == 0) {
+        cache->counters.misses++;
+        pthread_mutex_unlock(&cache->lock);
+        return RESULT_MISS;
+    }
+    found->lastUsed = ++cache->clock;
+    if (exact) {
+        cache->counters.hits++;
+    } else {
+        cache->counters.subsumedHits++;
+    }
+    int foundOrder = found->key.order;
+    candidates->bucket = bucket;
+    init_arena(&candidates->arena);
+    candidates->count = found->count;
+    candidates->ids = arena_alloc(&candidates->arena,
+            found->count * sizeof(uint32_t));
+    memcpy(candidates->ids, found->ids, found->count * sizeof(uint32_t));
+    pthread_mutex_unlock(&cache->lock);
+    if (exact) {
+        return RESULT_HIT;
+    }
+    candidates->count = filter_candidate_ids(bucket, filter, candidates->ids,
+            candidates->count, candidates->ids);
+    if (foundOrder != key->order || key->order == RESULT_ORDER_BEST) {
+        order_cached_result(bucket, key->order, candidates);
+    }
+    return RESULT_SUBSUMED;
+}
+
+/* void store_cached_result(ResultCache *cache, const ResultKey *key,
+*        const CandidateList *candidates)
+* -----------------------------------------------
+* Adds the complete result of a query to the cache, evicting the least
+* recently used results to make room. A result larger than the whole cache
+* is not kept.
+*
+* cache: the cache
+* key: the query's key
+* candidates: every match of the query, in the key's order
+*
+* Returns: -
+* Errors: -
+*/
+void store_cached_result(ResultCache *cache, const ResultKey *key,
+        const CandidateList *candidates)
+{
+    pthread_mutex_lock(&cache->lock);
+    // Another thread may have answered the same query in the meantime
+    for (int i = 0; i < cache->entryCount; i++) {
+        if (memcmp(&cache->entries[i].key, key, sizeof(*key)) == 0) {
+            pthread_mutex_unlock(&cache->lock);
+            return;
+        }
+    }
+    add_entry(cache, key, candidates->ids, candidates->count,
+            ++cache->clock);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* void get_result_cache_counters(ResultCache *cache,
+*        ResultCacheCounters *counters)
+* -----------------------------------------------
+* Reads how often lookups hit, were answered from a looser query or missed,
+* how many results have been evicted and what the cache holds now
+*
+* cache: the cache
+* counters: receives the counters
+*
+* Returns: -
+* Errors: -
+*/
+void get_result_cache_counters(ResultCache *cache,
+        ResultCacheCounters *counters)
+{
+    pthread_mutex_lock(&cache->lock);
+    *counters = cache->counters;
+    counters->entries = cache->entryCount;
+    counters->bytes = cache->usedBytes;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* void load_result_cache(ResultCache *cache, const WordBucket *bucket)
+* -----------------------------------------------
+* Fills an empty cache with the results cached on disk for a bucket, if
+* they were cached for the same words. Results that do not fit are evicted
+* as usual.
+*
+* cache: the cache
+* bucket: the bucket
+*
+* Returns: -
+* Errors: -
+*/
+void load_result_cache(ResultCache *cache, const WordBucket *bucket)
+{
+    char path[PATH_MAX];
+    ResultCacheHeader expected, header;
+    if (!get_result_cache_path(bucket, path, sizeof(path))) {
+        return;
+    }
+    FILE *file = fopen(path, "rb");
+    if (file == 0) {
+        return;
+    }
+    if (!fill_cache_header(cache, bucket, &expected)
+            || fread(&header, sizeof(header), 1, file) != 1
+            || memcmp(&header, &expected, offsetof(ResultCacheHeader,
+            entryCount)) != 0) {
+        fclose(file);
+        return;
+    }
+    uint32_t *ids = malloc(bucket->count * sizeof(uint32_t) + 1);
+    StoredEntry stored;
+    for (uint64_t i = 0; i < header.entryCount; i++) {
+        if (fread(&stored, sizeof(stored), 1, file) != 1
+                || stored.count > bucket->count
+                || fread(ids, sizeof(uint32_t), stored.count, file)
+                != stored.count) {
+            break;
+        }
+        add_entry(cache, &stored.key, ids, stored.count, stored.lastUsed);
+        if (stored.lastUsed > cache->clock) {
+            cache->clock = stored.lastUsed;
+        }
+    }
+    free(ids);
+    fclose(file);
+    cache->counters.hits = header.hits;
+    cache->counters.subsumedHits = header.subsumedHits;
+    cache->counters.misses = header.misses;
+    cache->counters.evictions = header.evictions;
+    cache->entriesChanged = 0;
+}
+
+/* void save_result_cache(ResultCache *cache, const WordBucket *bucket)
+* -----------------------------------------------
+* Keeps the cache on disk for the next run. If no result was added or
+* evicted only the counters are rewritten; otherwise the whole cache is
+* written with write_cache_file().
+*
+* cache: the cache
+* bucket: the bucket the results are for
+*
+* Returns: -
+* Errors: -
+*/
+void save_result_cache(ResultCache *cache, const WordBucket *bucket)
+{
+    char path[PATH_MAX];
+    ResultCacheHeader header;
+    if (!get_result_cache_path(bucket, path, sizeof(path))
+            || !fill_cache_header(cache, bucket, &header)) {
+        return;
+    }
+    if (!cache->entriesChanged) {
+        FILE *file = fopen(path, "r+b");
+        if (file) {
+            fwrite(&header, sizeof(header), 1, file);
+            fclose(file);
+        }
+        return;
+    }
+    ResultsFile resultsFile = {&header, cache};
+    write_cache_file(path, write_results_file, &resultsFile);
+}
+
+/* static int write_results_file(FILE *file, const void *context)
+* -----------------------------------------------
+* Writes the whole result cache to its file (see write_cache_file())
+*
+* file: the file being written
+* context: the ResultsFile to write
+*
+* Returns: 1 if every write succeeded, 0 otherwise
+* Errors: -
+*/
+static int write_results_file(FILE *file, const void *context)
+{
+    const ResultsFile *resultsFile = context;
+    const ResultCache *cache = resultsFile->cache;
+    int ok = fwrite(resultsFile->header, sizeof(*resultsFile->header), 1,
+            file) == 1;
+    for (int i = 0; ok && i < cache->entryCount; i++) {
+        const ResultEntry *entry = &cache->entries[i];
+        StoredEntry stored;
+        memset(&stored, 0, sizeof(stored));
+        stored.key = entry->key;
+        stored.lastUsed = entry->lastUsed;
+        stored.count = entry->count;
+        ok = fwrite(&stored, sizeof(stored), 1, file) == 1
+                && fwrite(entry->ids, sizeof(uint32_t), entry->count, file)
+                == entry->count;
+    }
+    return ok;
+}
+
+/* static int subsumes(const ResultKey *loose, const ResultKey *tight)
+* -----------------------------------------------
+* Checks whether every word matching one query also matches another: each
+* constraint of the looser query has to follow from the tighter one's
+*
+* loose: key of the query that may match more words
+* tight: key of the query that may match fewer words
+*
+* Returns: 1 if loose subsumes tight, 0 otherwise
+* Errors: -
+*/
+static int subsumes(const ResultKey *loose, const ResultKey *tight)
+{
+    int len = tight->len;
+    if (loose->len == len && tight->impossible) {
+        return 1;
+    } else if (loose->len != len || loose->impossible
+            || (loose->fixedMask & ~tight->fixedMask)
+            || (tight->fixedLetters & loose->fixedMask)
+            != loose->fixedLetters) {
+        return 0;
+    }
+    uint32_t absent = 0;
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        if (loose->minCounts[letter] > tight->minCounts[letter]
+                || loose->maxCounts[letter] < tight->maxCounts[letter]) {
+            return 0;
+        }
+        if (tight->maxCounts[letter] == 0) {
+            absent |= 1u << letter;
+        }
+    }
+    for (int pos = 0; pos < len; pos++) {
+        // Letters the tighter query never has at pos
+        uint32_t ruledOut = tight->excludedAt[pos] | absent;
+        if (get_packed_letter(tight->fixedMask, len, pos)) {
+            ruledOut |= ALL_LETTERS & ~(1u << get_packed_letter(
+                    tight->fixedLetters, len, pos));
+        }
+        if (loose->excludedAt[pos] & ~ruledOut) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* static void order_cached_result(const WordBucket *bucket, int order,
+*        CandidateList *candidates)
+* -----------------------------------------------
+* Puts a filtered result in the order a query asks for
+*
+* bucket: the bucket the words are from
+* order: RESULT_ORDER_BUCKET, RESULT_ORDER_ALPHA or RESULT_ORDER_BEST
+* candidates: the words, reordered in place
+*
+* Returns: -
+* Errors: -
+*/
+static void order_cached_result(const WordBucket *bucket, int order,
+        CandidateList *candidates)
+{
+    // Results narrowed from a cached list are short; one thread sorts them
+    if (order == RESULT_ORDER_ALPHA) {
+        sort_candidates_alphabetically(candidates, 1);
+    } else if (order == RESULT_ORDER_BEST) {
+        sort_candidates_by_score(candidates, 1);
+    } else {
+        // IDs increase in bucket order
+        int keyBits = 1;
+        while (keyBits < 32 && (bucket->count >> keyBits)) {
+            keyBits++;
+        }
+        uint64_t *keys = arena_alloc(&candidates->arena,
+                candidates->count * sizeof(uint64_t));
+        for (int i = 0; i < candidates->count; i++) {
+            keys[i] = candidates->ids[i];
+        }
+        radix_sort_unique(keys, candidates->ids, candidates->count, keyBits,
+                &candidates->arena);
+    }
+}
+
+/* static void add_entry(ResultCache *cache, const ResultKey *key,
+*        const uint32_t *ids, uint32_t count, uint64_t lastUsed)
+* -----------------------------------------------
+* Copies a result into the cache, evicting the least recently used results
+* until it fits. Called with the cache locked.
+*
+* cache: the cache
+* key: the query's key
+* ids: the matching words, in the key's order
+* count: number of matching words
+* lastUsed: when the result was last used
+*
+* Returns: -
+* Errors: -
+*/
+static void add_entry(ResultCache *cache, const ResultKey *key,
+        const uint32_t *ids, uint32_t count, uint64_t lastUsed)
+{
+    size_t size = get_entry_size(count);
+    if (size > cache->maxBytes) {
+        return;
+    }
+    while (cache->usedBytes + size > cache->maxBytes) {
+        evict_least_recent(cache);
+    }
+    if (cache->entryCount == cache->entryCapacity) {
+        cache->entryCapacity = cache->entryCapacity
+                ? cache->entryCapacity * 2 : 16;
+        cache->entries = realloc(cache->entries,
+                cache->entryCapacity * sizeof(ResultEntry));
+    }
+    ResultEntry *entry = &cache->entries[cache->entryCount++];
+    entry->key = *key;
+    entry->lastUsed = lastUsed;
+    entry->count = count;
+    entry->ids = malloc(count * sizeof(uint32_t) + 1);
+    if (count) {
+        memcpy(entry->ids, ids, count * sizeof(uint32_t));
+    }
+    cache->usedBytes += size;
+    cache->entriesChanged = 1;
+}
+
+/* static void evict_least_recent(ResultCache *cache)
+* -----------------------------------------------
+* Drops the result that has gone unused the longest. Called with the cache
+* locked and holding at least one result.
+*
+* cache: the cache
+*
+* Returns: -
+* Errors: -
+*/
+static void evict_least_recent(ResultCache *cache)
+{
+    int oldest = 0;
+    for (int i = 1; i < cache->entryCount; i++) {
+        if (cache->entries[i].lastUsed < cache->entries[oldest].lastUsed) {
+            oldest = i;
+        }
+    }
+    ResultEntry *entry = &cache->entries[oldest];
+    cache->usedBytes -= get_entry_size(entry->count);
+    free(entry->ids);
+    *entry = cache->entries[--cache->entryCount];
+    cache->counters.evictions++;
+    cache->entriesChanged = 1;
+}
+
+/* static size_t get_entry_size(uint32_t count)
+* -----------------------------------------------
+* Memory a cached result takes up
+*
+* count: number of words in the result
+*
+* Returns: the size in bytes
+* Errors: -
+*/
+static size_t get_entry_size(uint32_t count)
+{
+    return sizeof(ResultEntry) + (size_t) count * sizeof(uint32_t);
+}
+
+/* static int get_result_cache_path(const WordBucket *bucket, char *path,
+*        size_t size)
+* -----------------------------------------------
+* Works out where the results for a bucket of the dictionary are kept
+*
+* bucket: the bucket
+* path: buffer that receives the path
+* size: size of path
+*
+* Returns: 1 if there is a cache to keep them in, 0 otherwise
+* Errors: -
+*/
+static int get_result_cache_path(const WordBucket *bucket, char *path,
+        size_t size)
+{
+    char sourcePath[PATH_MAX], extension[16];
+    snprintf(extension, sizeof(extension), "rc%d", bucket->len);
+    return realpath(get_dictionary_path(), sourcePath)
+            && get_cache_path(sourcePath, extension, path, size);
+}
+
+/* static int fill_cache_header(const ResultCache *cache,
+*        const WordBucket *bucket, ResultCacheHeader *header)
+* -----------------------------------------------
+* Builds the header the results of a bucket are stored under
+*
+* cache: the cache, for its counters and results
+* bucket: the bucket
+* header: receives the header
+*
+* Returns: 1, or 0 if the dictionary cannot be examined
+* Errors: -
+*/
+static int fill_cache_header(const ResultCache *cache,
+        const WordBucket *bucket, ResultCacheHeader *header)
+{
+    struct stat st;
+    if (stat(get_dictionary_path(), &st) != 0) {
+        return 0;
+    }
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, RESULT_CACHE_MAGIC, sizeof(header->magic));
+    header->version = RESULT_CACHE_VERSION;
+    header->len = bucket->len;
+    header->count = bucket->count;
+    header->sourceSize = st.st_size;
+    header->sourceMtime = st.st_mtim.tv_sec;
+    header->sourceMtimeNsec = st.st_mtim.tv_nsec;
+    header->entryCount = cache->entryCount;
+    header->hits = cache->counters.hits;
+    header->subsumedHits = cache->counters.subsumedHits;
+    header->misses = cache->counters.misses;
+    header->evictions = cache->counters.evictions;
+    return 1;
+}
@@ -0,0 +1,98 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "wordle.h"
+#include "lettermask.h"
+#include "wordindex.h"
+#include "scan.h"
+
+// Size of the result cache of -serve in MB, unless WORDLE_RESULT_CACHE_MB
+// gives another (0 turns it off). The command line tool only keeps a cache,
+// on disk, when WORDLE_RESULT_CACHE_MB is set.
+#define DEFAULT_RESULT_CACHE_MB 16
+
+// Order of the words of a cached result: bucket order (no sorting option),
+// -alpha or -best
+#define RESULT_ORDER_BUCKET 0
+#define RESULT_ORDER_ALPHA 1
+#define RESULT_ORDER_BEST 2
+
+// Outcome of a lookup: no cache was consulted, nothing usable was found,
+// the query itself was cached, or a looser query's result was filtered
+#define RESULT_OFF 0
+#define RESULT_MISS 1
+#define RESULT_HIT 2
+#define RESULT_SUBSUMED 3
+
+/*
+* Struct Definitions
+*/
+// A query in canonical form: whatever way the pattern, -with, -without and
+// -feedback arguments were spelt, queries matching the same words get the
+// same key. minCounts and maxCounts bound how often each letter occurs
+// (NO_MAX_COUNT if it may occur any number of times) and excludedAt holds
+// the letters ruled out at each position that the bounds do not already
+// rule out everywhere. Queries no word can meet all share one key, with
+// impossible set and nothing else but len and order.
+typedef struct {
+    int32_t len;
+    int32_t order;
+    int32_t impossible;
+    int32_t reserved;
+    uint64_t fixedMask;
+    uint64_t fixedLetters;
+    uint32_t excludedAt[MAX_LEN];
+    uint8_t minCounts[ALPHABET_SIZE];
+    uint8_t maxCounts[ALPHABET_SIZE];
+} ResultKey;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t subsumedHits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytes;
+} ResultCacheCounters;
+
+typedef struct ResultEntry ResultEntry;
+
+// Complete results of earlier queries, evicting the least recently used
+// once they take up more than maxBytes. Safe to share between threads.
+typedef struct {
+    pthread_mutex_t lock;
+    size_t maxBytes;
+    size_t usedBytes;
+    ResultEntry *entries;
+    int entryCount;
+    int entryCapacity;
+    uint64_t clock;
+    ResultCacheCounters counters;
+    int entriesChanged;
+} ResultCache;
+
+/*
+* Function Prototypes
+*/
+size_t get_result_cache_limit(size_t defaultMb);
+void init_result_cache(ResultCache *cache, size_t maxBytes);
+void free_result_cache(ResultCache *cache);
+void make_result_key(const WordBucket *bucket, const ScanFilter *filter,
+        int order, ResultKey *key);
+int find_cached_result(ResultCache *cache, const WordBucket *bucket,
+        const ResultKey *key, const ScanFilter *filter,
+        CandidateList *candidates);
+void store_cached_result(ResultCache *cache, const ResultKey *key,
+        const CandidateList *candidates);
+void get_result_cache_counters(ResultCache *cache,
+        ResultCacheCounters *counters);
+void load_result_cache(ResultCache *cache, const WordBucket *bucket);
+void save_result_cache(ResultCache *cache, const WordBucket *bucket);
+
+#endif
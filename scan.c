@@ -0,0 +1,613 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdlib.h>
+#include <string.h>
+#include "scan.h"
+#include "lettermask.h"
+#include "bitsetindex.h"
+#include "filterkernel.h"
+#include "parallel.h"
+
+// Chunks smaller than this are not worth a thread of their own
+#define MIN_CHUNK_WORDS 16384
+// Chunks are filtered one segment at a time so the match bitmap stays small
+// and a chunk can stop early
+#define SEGMENT_WORDS 4096
+// Below this many words, sampling the tests of a query would cost about as
+// much as running them in a better order saves
+#define MIN_SAMPLED_WORDS (PREDICATE_SAMPLE_WORDS * 64)
+
+// Bit 0 of this is set if the letter at position pos of a LEN letter packed
+// word is ruled out there. Positions past the end of the word are 0; as LEN
+// is a constant in the length specialized filters below, the compiler drops
+// them and the rest need no loop.
+#define EXCLUDED_AT(pos, LEN) ((pos) < (LEN) \
+        ? excludedAt[pos] >> ((packed >> (((LEN) - 1 - (pos)) \
+        * LETTER_BITS)) & LETTER_FIELD) : 0)
+
+// Defines filter_candidates_LEN(), filter_candidate_ids() for words of LEN
+// letters with the position checks written out and a fixed word stride
+#define DEFINE_CANDIDATE_FILTER(LEN) \
+    static int filter_candidates_##LEN(const WordBucket *bucket, \
+            const ScanFilter *filter, const uint32_t *ids, int count, \
+            uint32_t *matches) \
+    { \
+        const LetterRequirements *requirements = &filter->requirements; \
+        const uint32_t *excludedAt = requirements->excludedAt; \
+        int matchCount = 0; \
+        for (int n = 0; n < count; n++) { \
+            uint32_t i = ids[n]; \
+            uint64_t packed = bucket->packed[i]; \
+            if ((packed & filter->fixedMask) != filter->fixedLetters) { \
+                continue; \
+            } \
+            uint32_t excluded = EXCLUDED_AT(0, LEN) | EXCLUDED_AT(1, LEN) \
+                    | EXCLUDED_AT(2, LEN) | EXCLUDED_AT(3, LEN) \
+                    | EXCLUDED_AT(4, LEN) | EXCLUDED_AT(5, LEN) \
+                    | EXCLUDED_AT(6, LEN) | EXCLUDED_AT(7, LEN) \
+                    | EXCLUDED_AT(8, LEN); \
+            if (!(excluded & 1) && matches_letter_requirements( \
+                    requirements, bucket->masks[i], &bucket->counts[i], \
+                    bucket->words + (size_t) i * ((LEN) + 1))) { \
+                matches[matchCount++] = i; \
+            } \
+        } \
+        return matchCount; \
+    }
+
+/*
+* Struct Definitions
+*/
+// The IDs of the words found in one chunk of the bucket, in bucket order.
+// ids has room for every word of the chunk, or for limit words.
+typedef struct {
+    uint32_t *ids;
+    int count;
+    int limit;
+} ScanChunk;
+
+typedef struct {
+    const WordBucket *bucket;
+    ScanFilter filter;
+    int chunkCount;
+    MatchVisitor visitor;
+    char *states;
+    size_t stateSize;
+} ScanContext;
+
+// Used to run several filters over a bucket in one pass
+typedef struct {
+    const WordBucket *bucket;
+    const ScanFilter *filters;
+    int filterCount;
+    int chunkCount;
+    uint64_t **results;
+} GroupContext;
+
+typedef int (*CandidateFilter)(const WordBucket *bucket,
+        const ScanFilter *filter, const uint32_t *ids, int count,
+        uint32_t *matches);
+
+/*
+* Function Prototypes
+*/
+static void get_chunk_range(const WordBucket *bucket, int chunkCount,
+        int chunk, uint32_t *first, uint32_t *end);
+static void filter_segment(const WordBucket *bucket, const ScanFilter *filter,
+        uint32_t first, uint32_t end, uint64_t *result);
+static void scan_chunk(int chunk, void *context);
+static void filter_group_chunk(int chunk, void *context);
+static int collect_match(uint32_t id, void *state);
+
+/* static int filter_candidates_LEN(const WordBucket *bucket,
+*        const ScanFilter *filter, const uint32_t *ids, int count,
+*        uint32_t *matches)
+* -----------------------------------------------
+* filter_candidate_ids() for a bucket of LEN letter words, one per length
+* from MIN_LEN to MAX_LEN
+*/
+DEFINE_CANDIDATE_FILTER(4)
+DEFINE_CANDIDATE_FILTER(5)
+DEFINE_CANDIDATE_FILTER(6)
+DEFINE_CANDIDATE_FILTER(7)
+DEFINE_CANDIDATE_FILTER(8)
+DEFINE_CANDIDATE_FILTER(9)
+
+// The candidate filter for each word length, from MIN_LEN
+static const CandidateFilter candidateFilters[MAX_LEN - MIN_LEN + 1] = {
+    filter_candidates_4, filter_candidates_5, filter_candidates_6,
+    filter_candidates_7, filter_candidates_8, filter_candidates_9
+};
+
+/* void compile_scan_filter(const WordBucket *bucket,
+*        const char *patternString, const char *withString,
+*        const char *withoutString, const FeedbackConstraints *feedback,
+*        ScanFilter *filter)
+* -----------------------------------------------
+* Compiles the arguments of a query for scanning a bucket, choosing between
+* the column and the positional bitset filters. A query no word can meet
+* is compiled into two tests that contradict each other, so the kernels
+* need no case of their own for it.
+*
+* bucket: the bucket that will be scanned
+* patternString: uppercase pattern, or NULL if no pattern was given
+* withString, withoutString: uppercase -with/-without values ("" if unset)
+* feedback: constraints from -feedback, or NULL if none was given
+* filter: receives the compiled filter
+*
+* Returns: -
+* Errors: -
+*/
+void compile_scan_filter(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, ScanFilter *filter)
+{
+    compile_letter_requirements(withString, withoutString,
+            &filter->requirements);
+    filter->impossible = feedback && !apply_feedback_constraints(feedback,
+            patternString, &filter->requirements);
+    if (filter->impossible) {
+        // Ask for an A at the first position and rule it out there: a
+        // query every kernel rejects every word of
+        patternString = 0;
+        compile_letter_requirements("", "", &filter->requirements);
+        filter->requirements.fixedAt[0] = 'A';
+        filter->requirements.excludedAt[0] = 1u << 0;
+    }
+    filter->patternString = patternString;
+    filter->fixedMask = filter->fixedLetters = 0;
+    for (int pos = 0; pos < bucket->len; pos++) {
+        char fixed = patternString && patternString[pos] != '_'
+                ? patternString[pos] : filter->requirements.fixedAt[pos];
+        int shift = (bucket->len - 1 - pos) * LETTER_BITS;
+        if (fixed) {
+            filter->fixedMask |= (uint64_t) LETTER_FIELD << shift;
+            filter->fixedLetters |= (uint64_t) (fixed - 'A') << shift;
+        }
+    }
+    list_predicates(bucket, patternString, &filter->requirements,
+            &filter->plan);
+    filter->checkCounts = withString[0] != '\0' || feedback;
+    filter->anyFilter = patternString || withString[0] || withoutString[0]
+            || feedback;
+    filter->useColumns = filter->anyFilter && prefer_column_scan(bucket,
+            &filter->plan);
+}
+
+/* void order_scan_filter(const WordBucket *bucket, ScanFilter *filter)
+* -----------------------------------------------
+* Puts the tests of a compiled filter that is about to be run over a whole
+* bucket in their most selective first order (see order_predicates()).
+* Small buckets keep the fixed order. The tests are only reordered, so the
+* words that pass stay the same.
+*
+* bucket: the bucket that will be scanned
+* filter: the filter, updated
+*
+* Returns: -
+* Errors: -
+*/
+void order_scan_filter(const WordBucket *bucket, ScanFilter *filter)
+{
+    if (bucket->count >= MIN_SAMPLED_WORDS && filter->plan.count > 1) {
+        order_predicates(bucket, &filter->plan);
+    }
+}
+
+/* int get_scan_chunk_count(const WordBucket *bucket, int threads)
+* -----------------------------------------------
+* Number of chunks (and so threads) a scan of the bucket is split into
+*
+* bucket: the bucket to be scanned
+* threads: maximum number of threads to use
+*
+* Returns: the number of chunks, at least 1
+* Errors: -
+*/
+int get_scan_chunk_count(const WordBucket *bucket, int threads)
+{
+    int chunkCount = (bucket->count + MIN_CHUNK_WORDS - 1) / MIN_CHUNK_WORDS;
+    if (chunkCount > threads) {
+        chunkCount = threads;
+    }
+    return chunkCount < 1 ? 1 : chunkCount;
+}
+
+/* void visit_matches(const WordBucket *bucket, const char *patternString,
+*        const char *withString, const char *withoutString,
+*        const FeedbackConstraints *feedback, int chunkCount,
+*        MatchVisitor visitor, void *states, size_t stateSize)
+* -----------------------------------------------
+* Finds every word in the bucket matching the pattern, -with, -without and
+* -feedback arguments and passes its ID to visitor. The bucket is split into
+* chunkCount chunks of consecutive words that are scanned in parallel, each
+* with its own visitor state; within a chunk, IDs are visited in increasing
+* order.
+*
+* bucket: the words of the requested length
+* patternString: uppercase pattern, or NULL if no pattern was given
+* withString, withoutString: uppercase -with/-without values ("" if unset)
+* feedback: constraints from -feedback, or NULL if none was given
+* chunkCount: number of chunks, from get_scan_chunk_count()
+* visitor: called for every match
+* states: array of chunkCount visitor states
+* stateSize: size of one visitor state
+*
+* Returns: -
+* Errors: -
+*/
+void visit_matches(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, int chunkCount,
+        MatchVisitor visitor, void *states, size_t stateSize)
+{
+    ScanContext context;
+    context.bucket = bucket;
+    compile_scan_filter(bucket, patternString, withString, withoutString,
+            feedback, &context.filter);
+    order_scan_filter(bucket, &context.filter);
+    context.chunkCount = chunkCount;
+    context.visitor = visitor;
+    context.states = states;
+    context.stateSize = stateSize;
+    run_parallel(chunkCount, scan_chunk, &context);
+}
+
+/* int scan_bucket(const WordBucket *bucket, const char *patternString,
+*        const char *withString, const char *withoutString,
+*        const FeedbackConstraints *feedback, int threads, int limit,
+*        CandidateList *candidates)
+* -----------------------------------------------
+* Collects every word in the bucket matching the pattern, -with, -without
+* and -feedback arguments. The chunks are filtered in parallel and their
+* results concatenated in bucket order, so the output does not depend on
+* the number of threads. Matches are recorded as word IDs in arena memory
+* sized up front, so the scan makes a constant number of allocations.
+*
+* bucket: the words of the requested length
+* patternString: uppercase pattern, or NULL if no pattern was given
+* withString, withoutString: uppercase -with/-without values ("" if unset)
+* feedback: constraints from -feedback, or NULL if none was given
+* threads: maximum number of threads to use
+* limit: if non-zero, only the first limit matches are collected and each
+*        chunk stops scanning once it has them
+* candidates: receives the matching words; release with free_candidates()
+*
+* Returns: the number of matching words collected
+* Errors: -
+*/
+int scan_bucket(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, int threads, int limit,
+        CandidateList *candidates)
+{
+    candidates->bucket = bucket;
+    init_arena(&candidates->arena);
+    int chunkCount = get_scan_chunk_count(bucket, threads);
+    ScanChunk chunks[chunkCount];
+    for (int i = 0; i < chunkCount; i++) {
+        uint32_t first, end;
+        get_chunk_range(bucket, chunkCount, i, &first, &end);
+        chunks[i].limit = limit && (uint32_t) limit < end - first ? limit
+                : (int) (end - first);
+        chunks[i].ids = arena_alloc(&candidates->arena,
+                chunks[i].limit * sizeof(uint32_t));
+        chunks[i].count = 0;
+    }
+    visit_matches(bucket, patternString, withString, withoutString, feedback,
+            chunkCount, collect_match, chunks, sizeof(ScanChunk));
+    int total = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        total += chunks[i].count;
+    }
+    if (chunkCount == 1) {
+        candidates->ids = chunks[0].ids;
+    } else {
+        candidates->ids = arena_alloc(&candidates->arena,
+                total * sizeof(uint32_t));
+        int count = 0;
+        for (int i = 0; i < chunkCount; i++) {
+            memcpy(candidates->ids + count, chunks[i].ids,
+                    chunks[i].count * sizeof(uint32_t));
+            count += chunks[i].count;
+        }
+    }
+    if (limit && total > limit) {
+        total = limit;
+    }
+    candidates->count = total;
+    return total;
+}
+
+/* void filter_bucket_group(const WordBucket *bucket,
+*        const ScanFilter *filters, int filterCount, int threads,
+*        uint64_t **results)
+* -----------------------------------------------
+* Runs several filters over a bucket in a single pass. The bucket is walked
+* one segment at a time and every filter is applied to a segment while it
+* is still in cache, so the bucket is read from memory once for the whole
+* group rather than once per filter. Chunks of the bucket are filtered in
+* parallel.
+*
+* bucket: the bucket to be scanned
+* filters: the compiled filters
+* filterCount: number of filters
+* threads: maximum number of threads to use
+* results: one bitmap per filter of get_bitset_words(bucket->count) words;
+*          bit i is set if word i passes the filter's positional and letter
+*          set tests (see collect_candidates())
+*
+* Returns: -
+* Errors: -
+*/
+void filter_bucket_group(const WordBucket *bucket, const ScanFilter *filters,
+        int filterCount, int threads, uint64_t **results)
+{
+    GroupContext context;
+    context.bucket = bucket;
+    context.filters = filters;
+    context.filterCount = filterCount;
+    context.chunkCount = get_scan_chunk_count(bucket, threads);
+    context.results = results;
+    run_parallel(context.chunkCount, filter_group_chunk, &context);
+}
+
+/* int collect_candidates(const WordBucket *bucket,
+*        const ScanFilter *filter, const uint64_t *matches,
+*        CandidateList *candidates)
+* -----------------------------------------------
+* Turns a bitmap from filter_bucket_group() into a candidate list in bucket
+* order, finishing the filter's check of repeated -with letters
+*
+* bucket: the scanned bucket
+* filter: the filter that produced the bitmap
+* matches: the bitmap
+* candidates: receives the matching words; release with free_candidates()
+*
+* Returns: the number of matching words
+* Errors: -
+*/
+int collect_candidates(const WordBucket *bucket, const ScanFilter *filter,
+        const uint64_t *matches, CandidateList *candidates)
+{
+    candidates->bucket = bucket;
+    init_arena(&candidates->arena);
+    size_t blocks = get_bitset_words(bucket->count);
+    size_t total = 0;
+    for (size_t block = 0; block < blocks; block++) {
+        total += __builtin_popcountll(matches[block]);
+    }
+    candidates->ids = arena_alloc(&candidates->arena,
+            total * sizeof(uint32_t));
+    int stride = bucket->len + 1;
+    int count = 0;
+    for (size_t block = 0; block < blocks; block++) {
+        for (uint64_t bits = matches[block]; bits; bits &= bits - 1) {
+            uint32_t i = block * 64 + __builtin_ctzll(bits);
+            if (filter->checkCounts && !matches_letter_requirements(
+                    &filter->requirements, bucket->masks[i],
+                    &bucket->counts[i],
+                    bucket->words + (size_t) i * stride)) {
+                continue;
+            }
+            candidates->ids[count++] = i;
+        }
+    }
+    candidates->count = count;
+    return count;
+}
+
+/* int narrow_candidates(const CandidateList *from, const ScanFilter *filter,
+*        CandidateList *candidates)
+* -----------------------------------------------
+* Applies a filter to the words of an earlier candidate list rather than to
+* the whole bucket, so the work grows with the number of words that are
+* left
+*
+* from: the words to filter, in bucket order
+* filter: the compiled filter
+* candidates: receives the words of from that pass, in the same order;
+*             release with free_candidates()
+*
+* Returns: the number of words that pass
+* Errors: -
+*/
+int narrow_candidates(const CandidateList *from, const ScanFilter *filter,
+        CandidateList *candidates)
+{
+    candidates->bucket = from->bucket;
+    init_arena(&candidates->arena);
+    candidates->ids = arena_alloc(&candidates->arena,
+            from->count * sizeof(uint32_t));
+    candidates->count = filter_candidate_ids(from->bucket, filter, from->ids,
+            from->count, candidates->ids);
+    return candidates->count;
+}
+
+/* int filter_candidate_ids(const WordBucket *bucket,
+*        const ScanFilter *filter, const uint32_t *ids, int count,
+*        uint32_t *matches)
+* -----------------------------------------------
+* Keeps the word IDs that pass a filter. Each word is checked on its own:
+* its fixed letters with one compare of the packed word, the letters ruled
+* out at each position without branching, then the letter requirements.
+* The work is done by the filter specialized for the bucket's word length,
+* picked once per call. Nothing is allocated.
+*
+* bucket: the bucket the IDs refer to
+* filter: the compiled filter
+* ids: the words to filter
+* count: number of IDs
+* matches: receives the IDs that pass, in the same order; room for count
+*          IDs, and may be ids itself
+*
+* Returns: the number of IDs that pass
+* Errors: -
+*/
+int filter_candidate_ids(const WordBucket *bucket, const ScanFilter *filter,
+        const uint32_t *ids, int count, uint32_t *matches)
+{
+    return candidateFilters[bucket->len - MIN_LEN](bucket, filter, ids,
+            count, matches);
+}
+
+/* void free_candidates(CandidateList *candidates)
+* -----------------------------------------------
+* Releases the memory holding a candidate list
+*
+* candidates: the list to be released
+*
+* Returns: -
+* Errors: -
+*/
+void free_candidates(CandidateList *candidates)
+{
+    free_arena(&candidates->arena);
+    candidates->ids = 0;
+    candidates->count = 0;
+}
+
+/* static void get_chunk_range(const WordBucket *bucket, int chunkCount,
+*        int chunk, uint32_t *first, uint32_t *end)
+* -----------------------------------------------
+* Works out which words belong to a chunk. Chunk boundaries fall on 64 word
+* blocks.
+*
+* bucket: the bucket being scanned
+* chunkCount: number of chunks
+* chunk: index of the chunk
+* first: receives the first word of the chunk
+* end: receives one past the last word of the chunk
+*
+* Returns: -
+* Errors: -
+*/
+static void get_chunk_range(const WordBucket *bucket, int chunkCount,
+        int chunk, uint32_t *first, uint32_t *end)
+{
+    size_t setWords = get_bitset_words(bucket->count);
+    size_t blocksPerChunk = (setWords + chunkCount - 1) / chunkCount;
+    size_t start = chunk * blocksPerChunk * 64;
+    size_t stop = (chunk + 1) * blocksPerChunk * 64;
+    *first = start < bucket->count ? start : bucket->count;
+    *end = stop < bucket->count ? stop : bucket->count;
+}
+
+/* static void filter_segment(const WordBucket *bucket,
+*        const ScanFilter *filter, uint32_t first, uint32_t end,
+*        uint64_t *result)
+* -----------------------------------------------
+* Filters the words first..end-1 of the bucket into a bitmap (bit 0 of
+* result[0] is word first). first must be a multiple of 64.
+*
+* bucket: the bucket being scanned
+* filter: the compiled filter
+* first: first word to filter
+* end: one past the last word to filter
+* result: receives the bitmap
+*
+* Returns: -
+* Errors: -
+*/
+static void filter_segment(const WordBucket *bucket, const ScanFilter *filter,
+        uint32_t first, uint32_t end, uint64_t *result)
+{
+    if (filter->useColumns) {
+        filter_bucket_columns(bucket, &filter->plan, first, end, result);
+    } else if (filter->anyFilter) {
+        match_position_bitsets(bucket, &filter->plan, first, end, result);
+    } else {
+        for (uint32_t i = first; i < end; i += 64) {
+            result[(i - first) / 64] = end - i >= 64 ? ~0ull
+                    : (1ull << (end - i)) - 1;
+        }
+    }
+}
+
+/* static void scan_chunk(int chunk, void *context)
+* -----------------------------------------------
+* Filters one chunk of the bucket, a segment at a time, and hands the
+* matches to the visitor. Runs on its own thread.
+*
+* chunk: index of the chunk
+* context: the ScanContext
+*
+* Returns: -
+* Errors: -
+*/
+static void scan_chunk(int chunk, void *context)
+{
+    ScanContext *scan = context;
+    const WordBucket *bucket = scan->bucket;
+    void *state = scan->states + chunk * scan->stateSize;
+    int stride = bucket->len + 1;
+    uint64_t matches[SEGMENT_WORDS / 64];
+    uint32_t first, end;
+    get_chunk_range(bucket, scan->chunkCount, chunk, &first, &end);
+    for (uint32_t segment = first; segment < end; segment += SEGMENT_WORDS) {
+        uint32_t segmentEnd = end - segment > SEGMENT_WORDS
+                ? segment + SEGMENT_WORDS : end;
+        filter_segment(bucket, &scan->filter, segment, segmentEnd, matches);
+        for (uint32_t block = 0; block < get_bitset_words(segmentEnd
+                - segment); block++) {
+            for (uint64_t bits = matches[block]; bits; bits &= bits - 1) {
+                uint32_t i = segment + block * 64 + __builtin_ctzll(bits);
+                // Repeated -with letters and feedback count bounds still
+                // need the packed count check
+                if (scan->filter.checkCounts && !matches_letter_requirements(
+                        &scan->filter.requirements, bucket->masks[i],
+                        &bucket->counts[i],
+                        bucket->words + (size_t) i * stride)) {
+                    continue;
+                }
+                if (!scan->visitor(i, state)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+/* static void filter_group_chunk(int chunk, void *context)
+* -----------------------------------------------
+* Applies every filter of a group to one chunk of the bucket, a segment at
+* a time. Runs on its own thread.
+*
+* chunk: index of the chunk
+* context: the GroupContext
+*
+* Returns: -
+* Errors: -
+*/
+static void filter_group_chunk(int chunk, void *context)
+{
+    GroupContext *group = context;
+    uint32_t first, end;
+    get_chunk_range(group->bucket, group->chunkCount, chunk, &first, &end);
+    for (uint32_t segment = first; segment < end; segment += SEGMENT_WORDS) {
+        uint32_t segmentEnd = end - segment > SEGMENT_WORDS
+                ? segment + SEGMENT_WORDS : end;
+        for (int i = 0; i < group->filterCount; i++) {
+            filter_segment(group->bucket, &group->filters[i], segment,
+                    segmentEnd, group->results[i] + segment / 64);
+        }
+    }
+}
+
+/* static int collect_match(uint32_t id, void *state)
+* -----------------------------------------------
+* Match visitor of scan_bucket(): appends the ID to the chunk's results
+*
+* id: ID of the matching word
+* state: the chunk's ScanChunk
+*
+* Returns: 0 once the chunk has reached its limit, 1 otherwise
+* Errors: -
+*/
+static int collect_match(uint32_t id, void *state)
+{
+    ScanChunk *chunk = state;
+    chunk->ids[chunk->count++] = id;
+    return chunk->count < chunk->limit;
+}
@@ -0,0 +1,92 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stdint.h>
+#include "wordindex.h"
+#include "lettermask.h"
+#include "arena.h"
+#include "feedback.h"
+#include "predicate.h"
+
+// Called for every matching word ID in a chunk with that chunk's state.
+// Returning 0 stops the scan of the chunk.
+typedef int (*MatchVisitor)(uint32_t id, void *state);
+
+/*
+* Struct Definitions
+*/
+// The pattern, -with, -without and -feedback arguments of a query compiled
+// for scanning a bucket. The letters fixed by the pattern or by feedback
+// are also kept as a packed word (fixedLetters) and the mask of the
+// positions they cover, so a packed word is checked with one compare.
+// plan lists the single-letter tests the filter kernels run, in order.
+// impossible is set if the feedback contradicts itself or the pattern.
+typedef struct {
+    const char *patternString;
+    LetterRequirements requirements;
+    PredicatePlan plan;
+    uint64_t fixedMask;
+    uint64_t fixedLetters;
+    int checkCounts;
+    int useColumns;
+    int anyFilter;
+    int impossible;
+} ScanFilter;
+
+// Matching words, as 32-bit IDs into the bucket (word id is stored at
+// bucket->words + id * (bucket->len + 1)). The IDs live in the arena.
+typedef struct {
+    const WordBucket *bucket;
+    uint32_t *ids;
+    int count;
+    Arena arena;
+} CandidateList;
+
+/*
+* Function Prototypes
+*/
+void compile_scan_filter(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, ScanFilter *filter);
+void order_scan_filter(const WordBucket *bucket, ScanFilter *filter);
+int get_scan_chunk_count(const WordBucket *bucket, int threads);
+void visit_matches(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, int chunkCount,
+        MatchVisitor visitor, void *states, size_t stateSize);
+int scan_bucket(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, int threads, int limit,
+        CandidateList *candidates);
+void filter_bucket_group(const WordBucket *bucket, const ScanFilter *filters,
+        int filterCount, int threads, uint64_t **results);
+int collect_candidates(const WordBucket *bucket, const ScanFilter *filter,
+        const uint64_t *matches, CandidateList *candidates);
+int narrow_candidates(const CandidateList *from, const ScanFilter *filter,
+        CandidateList *candidates);
+int filter_candidate_ids(const WordBucket *bucket, const ScanFilter *filter,
+        const uint32_t *ids, int count, uint32_t *matches);
+void free_candidates(CandidateList *candidates);
+
+/* static inline const char *get_candidate_word(
+*        const CandidateList *candidates, int i)
+* -----------------------------------------------
+* Looks up the word of the i-th candidate
+*
+* candidates: the candidate list
+* i: position in the list
+*
+* Returns: the NUL terminated word inside the bucket
+* Errors: -
+*/
+static inline const char *get_candidate_word(const CandidateList *candidates,
+        int i)
+{
+    return candidates->bucket->words
+            + (size_t) candidates->ids[i] * (candidates->bucket->len + 1);
+}
+
+#endif
@@ -0,0 +1,137 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <string.h>
+#include "score.h"
+
+// A word is scored as a guess against a set of candidates: it earns the
+// (scaled) number of candidates containing each of its distinct letters,
+// plus the (scaled) number of candidates with the same letter in the same
+// position for each position. Words that test common letters, in their
+// common positions, narrow the candidates down the most.
+
+/* void add_letter_stats(LetterStats *stats, const char *word,
+*        uint32_t mask, int len)
+* -----------------------------------------------
+* Counts one candidate into the letter statistics
+*
+* stats: statistics to update
+* word: the candidate
+* mask: letter mask of the candidate
+* len: length of the candidate
+*
+* Returns: -
+* Errors: -
+*/
+void add_letter_stats(LetterStats *stats, const char *word, uint32_t mask,
+        int len)
+{
+    stats->total++;
+    for (mask &= (1u << ALPHABET_SIZE) - 1; mask; mask &= mask - 1) {
+        stats->present[__builtin_ctz(mask)]++;
+    }
+    for (int pos = 0; pos < len; pos++) {
+        stats->placed[pos][word[pos] - 'A']++;
+    }
+}
+
+/* void merge_letter_stats(LetterStats *stats, const LetterStats *other)
+* -----------------------------------------------
+* Adds the statistics gathered by another thread
+*
+* stats: statistics to update
+* other: statistics to add
+*
+* Returns: -
+* Errors: -
+*/
+void merge_letter_stats(LetterStats *stats, const LetterStats *other)
+{
+    stats->total += other->total;
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        stats->present[letter] += other->present[letter];
+        for (int pos = 0; pos < MAX_LEN; pos++) {
+            stats->placed[pos][letter] += other->placed[pos][letter];
+        }
+    }
+}
+
+/* void build_score_table(const LetterStats *stats, int len,
+*        ScoreTable *table)
+* -----------------------------------------------
+* Scales the letter statistics of a candidate set into per-letter scores
+*
+* stats: statistics of the candidate set
+* len: word length
+* table: receives the scores
+*
+* Returns: -
+* Errors: -
+*/
+void build_score_table(const LetterStats *stats, int len, ScoreTable *table)
+{
+    uint64_t total = stats->total ? stats->total : 1;
+    table->len = len;
+    for (int letter = 0; letter < ALPHABET_SIZE; letter++) {
+        table->presentScore[letter] = stats->present[letter] * SCORE_SCALE
+                / total;
+        for (int pos = 0; pos < len; pos++) {
+            table->placedScore[pos][letter] = stats->placed[pos][letter]
+                    * SCORE_SCALE / total;
+        }
+    }
+}
+
+/* uint32_t score_word(const ScoreTable *table, const char *word,
+*        uint32_t mask)
+* -----------------------------------------------
+* Scores a word as a guess
+*
+* table: scores of the candidate set
+* word: the word to score
+* mask: letter mask of the word
+*
+* Returns: the score, below 1 << SCORE_BITS
+* Errors: -
+*/
+uint32_t score_word(const ScoreTable *table, const char *word,
+        uint32_t mask)
+{
+    uint32_t score = 0;
+    for (mask &= (1u << ALPHABET_SIZE) - 1; mask; mask &= mask - 1) {
+        score += table->presentScore[__builtin_ctz(mask)];
+    }
+    for (int pos = 0; pos < table->len; pos++) {
+        score += table->placedScore[pos][word[pos] - 'A'];
+    }
+    return score;
+}
+
+/* void score_candidates(const CandidateList *candidates, uint32_t *scores)
+* -----------------------------------------------
+* Scores every candidate as a guess against the candidate set itself. One
+* pass over the candidates gathers the letter statistics and a second pass
+* scores them.
+*
+* candidates: the candidate list
+* scores: receives one score per candidate
+*
+* Returns: -
+* Errors: -
+*/
+void score_candidates(const CandidateList *candidates, uint32_t *scores)
+{
+    const WordBucket *bucket = candidates->bucket;
+    LetterStats stats;
+    ScoreTable table;
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < candidates->count; i++) {
+        add_letter_stats(&stats, get_candidate_word(candidates, i),
+                bucket->masks[candidates->ids[i]], bucket->len);
+    }
+    build_score_table(&stats, bucket->len, &table);
+    for (int i = 0; i < candidates->count; i++) {
+        scores[i] = score_word(&table, get_candidate_word(candidates, i),
+                bucket->masks[candidates->ids[i]]);
+    }
+}
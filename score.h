@@ -0,0 +1,43 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef SCORE_H
+#define SCORE_H
+
+#include <stdint.h>
+#include "lettermask.h"
+#include "scan.h"
+
+// Letter frequencies are scaled to 0..SCORE_SCALE before being summed, so
+// a score always fits in SCORE_BITS bits
+#define SCORE_SCALE 4095
+#define SCORE_BITS 17
+
+/*
+* Struct Definitions
+*/
+// How many candidates contain each letter, and have it at each position
+typedef struct {
+    uint64_t total;
+    uint64_t present[ALPHABET_SIZE];
+    uint64_t placed[MAX_LEN][ALPHABET_SIZE];
+} LetterStats;
+
+typedef struct {
+    int len;
+    uint32_t presentScore[ALPHABET_SIZE];
+    uint32_t placedScore[MAX_LEN][ALPHABET_SIZE];
+} ScoreTable;
+
+/*
+* Function Prototypes
+*/
+void add_letter_stats(LetterStats *stats, const char *word, uint32_t mask,
+        int len);
+void merge_letter_stats(LetterStats *stats, const LetterStats *other);
+void build_score_table(const LetterStats *stats, int len, ScoreTable *table);
+uint32_t score_word(const ScoreTable *table, const char *word,
+        uint32_t mask);
+void score_candidates(const CandidateList *candidates, uint32_t *scores);
+
+#endif
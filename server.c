@@ -0,0 +1,499 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "server.h"
+#include "dictionary.h"
+#include "wordindex.h"
+#include "query.h"
+#include "output.h"
+#include "session.h"
+#include "resultcache.h"
+
+// Queries are answered one line at a time: the client sends the command
+// line arguments of a query (e.g. "-len 6 -with ae -alpha") on one line and
+// gets back what the command line tool would print (the matching words, or
+// its error message), followed by the exit status the tool would have
+// returned, one record each in the output format (see output.h). A client
+// sending "-session" turns the rest of its connection into a session (see
+// session.h), so later lines narrow the words left by the earlier ones;
+// "-session" sent again within it is answered with status 1 ("-reset"
+// starts over). Results are cached (see resultcache.h); "-cachestats" gets back the
+// counters of the cache, one "name value" record each, then status 0.
+//
+// A worker serves one connection from its first line until the client
+// closes it, so at most as many clients as there are workers are answered
+// at a time and the rest wait in the queue of pending connections. A client
+// should keep its connection open for as many queries as it has, but close
+// it once it is idle.
+//
+// The dictionary index is shared by every worker and swapped RCU style when
+// the dictionary changes: the new index is published with one atomic store
+// and the old one is released only after every worker that could still be
+// using it has finished its query. Workers never wait for a reload.
+
+// Connections accepted but not yet picked up by a worker
+#define PENDING_CONNECTIONS 64
+// How often the dictionary is checked for changes
+#define RELOAD_INTERVAL_MS 1000
+// How long a reload waits between checks for workers still on the old index
+#define GRACE_POLL_MS 1
+
+/*
+* Struct Definitions
+*/
+// An index, the state of the dictionary file it was built from and the
+// results of queries answered from it
+typedef struct {
+    WordIndex *index;
+    struct stat source;
+    ResultCache cache;
+} ServedIndex;
+
+typedef struct {
+    const char *dictionaryPath;
+    int format;
+    size_t cacheSize;
+    ServedIndex *current;
+    // Bumped every time a new index is published
+    uint64_t generation;
+    // Generation each worker's query started in, or 0 while it is idle
+    uint64_t *readerGenerations;
+    int workerCount;
+    // Accepted connections waiting for a worker
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+    int pending[PENDING_CONNECTIONS];
+    int pendingHead;
+    int pendingCount;
+} Server;
+
+typedef struct {
+    Server *server;
+    int worker;
+} WorkerContext;
+
+/*
+* Function Prototypes
+*/
+static int open_listening_socket(const char *socketPath);
+static void *run_worker(void *arg);
+static void *run_reloader(void *arg);
+static void serve_connection(Server *server, int worker, int fd);
+static void answer_query(Server *server, int worker, char *line,
+        Session *session, OutputWriter *out);
+static void write_cache_stats(ResultCache *cache, OutputWriter *out);
+static int is_cache_stats_command(const char *line);
+static int same_source(const struct stat *a, const struct stat *b);
+static void sleep_ms(long ms);
+
+/* int serve_queries(const char *socketPath, int workers, int format)
+* -----------------------------------------------
+* Loads and indexes the dictionary once, then answers queries from clients
+* connecting to a Unix domain socket, with a pool of worker threads each
+* serving one connection at a time. A background thread reloads the
+* dictionary whenever the file changes. Only returns if the socket cannot
+* be set up.
+*
+* socketPath: path of the socket to listen on; a stale socket there is
+*             replaced
+* workers: number of worker threads
+* format: output format of the answers, unless a query picks its own
+*
+* Returns: SERVE_ERROR_STATUS
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+int serve_queries(const char *socketPath, int workers, int format)
+{
+    Server server;
+    memset(&server, 0, sizeof(server));
+    server.dictionaryPath = get_dictionary_path();
+    server.format = format;
+    server.cacheSize = get_result_cache_limit(DEFAULT_RESULT_CACHE_MB);
+    server.current = calloc(1, sizeof(ServedIndex));
+    if (stat(server.dictionaryPath, &server.current->source) != 0) {
+        report_dictionary_error(server.dictionaryPath);
+    }
+    server.current->index = open_word_index(0);
+    init_result_cache(&server.current->cache, server.cacheSize);
+    server.generation = 1;
+    server.workerCount = workers;
+    server.readerGenerations = calloc(workers, sizeof(uint64_t));
+    pthread_mutex_init(&server.lock, 0);
+    pthread_cond_init(&server.notEmpty, 0);
+    pthread_cond_init(&server.notFull, 0);
+    int listenFd = open_listening_socket(socketPath);
+    if (listenFd < 0) {
+        fprintf(stderr, "wordle-helper: unable to listen on \"%s\"\n",
+                socketPath);
+        return SERVE_ERROR_STATUS;
+    }
+    // A client hanging up mid-answer must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+    WorkerContext contexts[workers];
+    pthread_t thread;
+    for (int i = 0; i < workers; i++) {
+        contexts[i].server = &server;
+        contexts[i].worker = i;
+        pthread_create(&thread, 0, run_worker, &contexts[i]);
+        pthread_detach(thread);
+    }
+    pthread_create(&thread, 0, run_reloader, &server);
+    pthread_detach(thread);
+    while (1) {
+        int fd = accept(listenFd, 0, 0);
+        if (fd < 0) {
+            continue;
+        }
+        pthread_mutex_lock(&server.lock);
+        while (server.pendingCount == PENDING_CONNECTIONS) {
+            pthread_cond_wait(&server.notFull, &server.lock);
+        }
+        server.pending[(server.pendingHead + server.pendingCount)
+                % PENDING_CONNECTIONS] = fd;
+        server.pendingCount++;
+        pthread_cond_signal(&server.notEmpty);
+        pthread_mutex_unlock(&server.lock);
+    }
+}
+
+/* static int open_listening_socket(const char *socketPath)
+* -----------------------------------------------
+* Creates the server's Unix domain socket, replacing a socket left behind
+* by an earlier run
+*
+* socketPath: path of the socket
+*
+* Returns: the listening socket, or -1 on failure
+* Errors: -
+*/
+static int open_listening_socket(const char *socketPath)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    strcpy(address.sun_path, socketPath);
+    struct stat st;
+    if (lstat(socketPath, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(socketPath);
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0
+            || listen(fd, PENDING_CONNECTIONS) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* static void *run_worker(void *arg)
+* -----------------------------------------------
+* Worker thread: takes accepted connections off the queue and serves them
+*
+* arg: the worker's WorkerContext
+*
+* Returns: never returns
+* Errors: -
+*/
+static void *run_worker(void *arg)
+{
+    WorkerContext *context = arg;
+    Server *server = context->server;
+    while (1) {
+        pthread_mutex_lock(&server->lock);
+        while (server->pendingCount == 0) {
+            pthread_cond_wait(&server->notEmpty, &server->lock);
+        }
+        int fd = server->pending[server->pendingHead];
+        server->pendingHead = (server->pendingHead + 1) % PENDING_CONNECTIONS;
+        server->pendingCount--;
+        pthread_cond_signal(&server->notFull);
+        pthread_mutex_unlock(&server->lock);
+        serve_connection(server, context->worker, fd);
+    }
+    return 0;
+}
+
+/* static void *run_reloader(void *arg)
+* -----------------------------------------------
+* Reload thread: checks the dictionary for changes and swaps in a fresh
+* index when it has changed. The new index is built while the workers keep
+* answering from the old one, which is closed once no worker can still be
+* reading it, along with the results cached for it. If the new dictionary
+* cannot be read the old index stays in service.
+*
+* arg: the Server
+*
+* Returns: never returns
+* Errors: -
+*/
+static void *run_reloader(void *arg)
+{
+    Server *server = arg;
+    while (1) {
+        sleep_ms(RELOAD_INTERVAL_MS);
+        ServedIndex *old = server->current;
+        struct stat st;
+        if (stat(server->dictionaryPath, &st) != 0
+                || same_source(&st, &old->source)) {
+            continue;
+        }
+        WordIndex *index = load_word_index(server->dictionaryPath, 0);
+        if (index == 0) {
+            fprintf(stderr, "wordle-helper: dictionary file \"%s\" cannot "
+                    "be opened, keeping the old one\n",
+                    server->dictionaryPath);
+            continue;
+        }
+        ServedIndex *fresh = malloc(sizeof(ServedIndex));
+        fresh->index = index;
+        fresh->source = st;
+        init_result_cache(&fresh->cache, server->cacheSize);
+        __atomic_store_n(&server->current, fresh, __ATOMIC_SEQ_CST);
+        uint64_t generation = __atomic_add_fetch(&server->generation, 1,
+                __ATOMIC_SEQ_CST);
+        // Wait out queries that started before the new index was published
+        for (int i = 0; i < server->workerCount; i++) {
+            while (1) {
+                uint64_t reader = __atomic_load_n(
+                        &server->readerGenerations[i], __ATOMIC_SEQ_CST);
+                if (reader == 0 || reader >= generation) {
+                    break;
+                }
+                sleep_ms(GRACE_POLL_MS);
+            }
+        }
+        close_word_index(old->index);
+        free_result_cache(&old->cache);
+        free(old);
+    }
+    return 0;
+}
+
+/* static void serve_connection(Server *server, int worker, int fd)
+* -----------------------------------------------
+* Answers every query line sent on a connection until the client closes it,
+* keeping the worker for the whole connection. Once the client has sent
+* "-session" (answered with status 0), the lines are answered as turns of
+* the connection's session.
+*
+* server: the server
+* worker: index of the worker serving the connection
+* fd: the connected socket, closed on return
+*
+* Returns: -
+* Errors: -
+*/
+static void serve_connection(Server *server, int worker, int fd)
+{
+    FILE *in = fdopen(fd, "r");
+    if (in == 0) {
+        close(fd);
+        return;
+    }
+    OutputWriter out;
+    init_output_writer(&out, fd, server->format);
+    Session session;
+    init_session(&session);
+    int inSession = 0;
+    char *line = 0;
+    size_t size = 0;
+    while (getline(&line, &size, in) >= 0) {
+        if (!inSession && get_session_command(line) == SESSION_START) {
+            WordleArguments args;
+            args.status = 0;
+            write_answer_end(&args, 0, &out);
+            inSession = 1;
+        } else {
+            answer_query(server, worker, line, inSession ? &session : 0,
+                    &out);
+        }
+        if (flush_output(&out) != 0) {
+            break;
+        }
+    }
+    free(line);
+    free_session(&session);
+    free_output_writer(&out);
+    fclose(in);
+}
+
+/* static void answer_query(Server *server, int worker, char *line,
+*        Session *session, OutputWriter *out)
+* -----------------------------------------------
+* Parses one query line with the command line grammar and writes its
+* answer, in the query's own -format if it has one. Unless the query asks
+* for more with -threads, it is answered on the worker's own thread; it
+* gets at most as many threads as the server has workers. A
+* session whose words came from an index that has since been replaced is
+* replayed against the current one first. Outside of a session,
+* "-cachestats" is answered with the counters of the result cache.
+*
+* server: the server
+* worker: index of the worker answering
+* line: the query, split up in place
+* session: the connection's session, or NULL outside of one
+* out: where the answer is written
+*
+* Returns: -
+* Errors: -
+*/
+static void answer_query(Server *server, int worker, char *line,
+        Session *session, OutputWriter *out)
+{
+    if (session) {
+        uint64_t generation = __atomic_load_n(&server->generation,
+                __ATOMIC_SEQ_CST);
+        __atomic_store_n(&server->readerGenerations[worker], generation,
+                __ATOMIC_SEQ_CST);
+        ServedIndex *served = __atomic_load_n(&server->current,
+                __ATOMIC_SEQ_CST);
+        // Comparing the generation too rules out a new index that happens
+        // to be allocated where the session's old one was
+        if (session->turnCount && (session->index != served->index
+                || session->generation != generation)) {
+            rebind_session(session, served->index, 1);
+        }
+        session->generation = generation;
+        answer_session_line(session, served->index, line, 1,
+                server->workerCount, out);
+        __atomic_store_n(&server->readerGenerations[worker], 0,
+                __ATOMIC_RELEASE);
+        return;
+    } else if (is_cache_stats_command(line)) {
+        uint64_t generation = __atomic_load_n(&server->generation,
+                __ATOMIC_SEQ_CST);
+        __atomic_store_n(&server->readerGenerations[worker], generation,
+                __ATOMIC_SEQ_CST);
+        ServedIndex *served = __atomic_load_n(&server->current,
+                __ATOMIC_SEQ_CST);
+        write_cache_stats(&served->cache, out);
+        __atomic_store_n(&server->readerGenerations[worker], 0,
+                __ATOMIC_RELEASE);
+        return;
+    }
+    WordleArguments args = parse_query_line(line);
+    int status = args.status;
+    if (!status) {
+        if (args.formatFlag) {
+            out->format = args.format;
+        }
+        if (!args.threadsFlag) {
+            args.threads = 1;
+        } else if (args.threads > server->workerCount) {
+            // A client cannot make the shared server start more threads
+            args.threads = server->workerCount;
+        }
+        uint64_t generation = __atomic_load_n(&server->generation,
+                __ATOMIC_SEQ_CST);
+        __atomic_store_n(&server->readerGenerations[worker], generation,
+                __ATOMIC_SEQ_CST);
+        ServedIndex *served = __atomic_load_n(&server->current,
+                __ATOMIC_SEQ_CST);
+        status = compare_with_dictionary(
+                get_word_bucket(served->index, args.len), &args,
+                server->cacheSize ? &served->cache : 0, out, 0);
+        __atomic_store_n(&server->readerGenerations[worker], 0,
+                __ATOMIC_RELEASE);
+    }
+    write_answer_end(&args, status, out);
+    out->format = server->format;
+}
+
+/* static void write_cache_stats(ResultCache *cache, OutputWriter *out)
+* -----------------------------------------------
+* Answers "-cachestats": every counter of the result cache as a "name value"
+* record, then exit status 0
+*
+* cache: the result cache of the current index
+* out: where the answer is written
+*
+* Returns: -
+* Errors: -
+*/
+static void write_cache_stats(ResultCache *cache, OutputWriter *out)
+{
+    ResultCacheCounters counters;
+    get_result_cache_counters(cache, &counters);
+    const char *const names[] = {"hits", "subsumed_hits", "misses",
+            "evictions", "entries", "bytes"};
+    const uint64_t values[] = {counters.hits, counters.subsumedHits,
+            counters.misses, counters.evictions, counters.entries,
+            counters.bytes};
+    char record[64];
+    for (int i = 0; i < 6; i++) {
+        int len = snprintf(record, sizeof(record), "%s %lu", names[i],
+                (unsigned long) values[i]);
+        write_record(out, record, len);
+    }
+    write_record(out, "0", 1);
+}
+
+/* static int is_cache_stats_command(const char *line)
+* -----------------------------------------------
+* Recognises a "-cachestats" line
+*
+* line: the line, with or without surrounding whitespace
+*
+* Returns: 1 if the line asks for the result cache counters, 0 otherwise
+* Errors: -
+*/
+static int is_cache_stats_command(const char *line)
+{
+    static const char command[] = "-cachestats";
+    line += strspn(line, " \t\r\n");
+    size_t len = strcspn(line, " \t\r\n");
+    return len == strlen(command) && strncmp(line, command, len) == 0
+            && line[len + strspn(line + len, " \t\r\n")] == '\0';
+}
+
+/* static int same_source(const struct stat *a, const struct stat *b)
+* -----------------------------------------------
+* Checks whether two stat() results describe the same, unmodified file
+*
+* a, b: the stat() results
+*
+* Returns: 1 if they match, 0 otherwise
+* Errors: -
+*/
+static int same_source(const struct stat *a, const struct stat *b)
+{
+    return a->st_dev == b->st_dev && a->st_ino == b->st_ino
+            && a->st_size == b->st_size
+            && a->st_mtim.tv_sec == b->st_mtim.tv_sec
+            && a->st_mtim.tv_nsec == b->st_mtim.tv_nsec;
+}
+
+/* static void sleep_ms(long ms)
+* -----------------------------------------------
+* Sleeps for the given number of milliseconds
+*
+* ms: time to sleep
+*
+* Returns: -
+* Errors: -
+*/
+static void sleep_ms(long ms)
+{
+    struct timespec delay = {ms / 1000, (ms % 1000) * 1000000};
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+    }
+}
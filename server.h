@@ -0,0 +1,15 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef SERVER_H
+#define SERVER_H
+
+// Exit code of -serve when the socket cannot be set up
+#define SERVE_ERROR_STATUS 5
+
+/*
+* Function Prototypes
+*/
+int serve_queries(const char *socketPath, int workers, int format);
+
+#endif
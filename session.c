@@ -0,0 +1,334 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "session.h"
+#include "dictionary.h"
+
+// A session follows one game: every query line adds the constraints of a
+// turn (its pattern, -with, -without and -feedback arguments) to those of
+// the turns before it. Only the first turn scans the dictionary; each later
+// turn filters just the words the previous turn left, so its cost grows
+// with the number of words still possible rather than with the dictionary.
+// The -alpha, -best, -entropy, -limit and -format arguments of a line only
+// affect how its answer is printed.
+//
+// Every turn keeps its own candidate list, so "-undo" drops the last turn
+// and goes back to the words that were possible before it, and "-reset"
+// starts a new game. Queries after the first take the word length of the
+// session unless they give the same -len. Every line is answered like a
+// -batch query, with the command lines answered by their status alone
+// (1 if there is no turn to undo, and for "-session", as the session has
+// already started).
+
+// Turns a session has room for before it grows
+#define INITIAL_TURNS 8
+
+/*
+* Function Prototypes
+*/
+static WordleArguments parse_session_query(const Session *session,
+        char *line);
+static int narrow_turn(Session *session, int turn, int threads);
+static int print_turn(const SessionTurn *turn, const WordleArguments *args,
+        OutputWriter *out);
+static void drop_turns(Session *session, int turnCount);
+
+/* void init_session(Session *session)
+* -----------------------------------------------
+* Starts a session with no turns
+*
+* session: the session
+*
+* Returns: -
+* Errors: -
+*/
+void init_session(Session *session)
+{
+    memset(session, 0, sizeof(*session));
+}
+
+/* int get_session_command(const char *line)
+* -----------------------------------------------
+* Recognises the lines of a session that are commands rather than queries
+*
+* line: the line, with or without surrounding whitespace
+*
+* Returns: SESSION_START for "-session", SESSION_UNDO for "-undo",
+*          SESSION_RESET for "-reset", or 0 for a query
+* Errors: -
+*/
+int get_session_command(const char *line)
+{
+    static const char *const commands[] = {"-session", "-undo", "-reset"};
+    line += strspn(line, " \t\r\n");
+    size_t len = strcspn(line, " \t\r\n");
+    if (line[len + strspn(line + len, " \t\r\n")] != '\0') {
+        return 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (strlen(commands[i]) == len
+                && strncmp(line, commands[i], len) == 0) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/* void answer_session_line(Session *session, const WordIndex *index,
+*        char *line, int threads, int maxThreads, OutputWriter *out)
+* -----------------------------------------------
+* Answers one line of a session: a query narrows the words still possible
+* and prints them, a command undoes the last turn or starts over, and
+* "-session" is refused with status 1
+*
+* session: the session
+* index: the dictionary index; once the session has turns, the one it was
+*        started on or last rebound to with rebind_session()
+* line: the line, split up in place
+* threads: number of threads to use, unless the query gives -threads
+* maxThreads: most threads -threads can ask for, or 0 for no limit
+* out: where the answer is written
+*
+* Returns: -
+* Errors: -
+*/
+void answer_session_line(Session *session, const WordIndex *index,
+        char *line, int threads, int maxThreads, OutputWriter *out)
+{
+    WordleArguments args;
+    int command = get_session_command(line);
+    if (command) {
+        args.status = 0;
+        if (command == SESSION_START
+                || (command == SESSION_UNDO && session->turnCount == 0)) {
+            write_answer_end(&args, 1, out);
+            return;
+        }
+        drop_turns(session, command == SESSION_UNDO
+                ? session->turnCount - 1 : 0);
+        write_answer_end(&args, 0, out);
+        return;
+    }
+    args = parse_session_query(session, line);
+    int status = args.status;
+    if (!status) {
+        int format = out->format;
+        if (args.formatFlag) {
+            out->format = args.format;
+        }
+        if (!args.threadsFlag) {
+            args.threads = threads;
+        } else if (maxThreads && args.threads > maxThreads) {
+            args.threads = maxThreads;
+        }
+        if (session->turnCount == session->capacity) {
+            session->capacity = session->capacity ? session->capacity * 2
+                    : INITIAL_TURNS;
+            session->turns = realloc(session->turns,
+                    session->capacity * sizeof(SessionTurn));
+        }
+        if (session->turnCount == 0) {
+            session->index = index;
+            session->len = args.len;
+        }
+        SessionTurn *turn = &session->turns[session->turnCount];
+        turn->args = args;
+        narrow_turn(session, session->turnCount++, args.threads);
+        status = print_turn(turn, &args, out);
+        write_answer_end(&args, status, out);
+        out->format = format;
+        return;
+    }
+    write_answer_end(&args, status, out);
+}
+
+/* void rebind_session(Session *session, const WordIndex *index,
+*        int threads)
+* -----------------------------------------------
+* Moves a session to a new index, e.g. after the dictionary was reloaded,
+* by replaying its turns against the new words
+*
+* session: the session
+* index: the new index
+* threads: number of threads to scan with
+*
+* Returns: -
+* Errors: -
+*/
+void rebind_session(Session *session, const WordIndex *index, int threads)
+{
+    session->index = index;
+    for (int turn = 0; turn < session->turnCount; turn++) {
+        free_candidates(&session->turns[turn].candidates);
+        narrow_turn(session, turn, threads);
+    }
+}
+
+/* void free_session(Session *session)
+* -----------------------------------------------
+* Releases the memory held by a session
+*
+* session: the session
+*
+* Returns: -
+* Errors: -
+*/
+void free_session(Session *session)
+{
+    drop_turns(session, 0);
+    free(session->turns);
+    init_session(session);
+}
+
+/* int run_session(int threads, int format)
+* -----------------------------------------------
+* Plays a session with queries read from stdin, answering each line as soon
+* as it has been read
+*
+* threads: number of threads to use
+* format: output format of the answers, unless a query picks its own
+*
+* Returns: 0 at the end of the input
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+int run_session(int threads, int format)
+{
+    WordIndex *index = open_word_index(0);
+    OutputWriter out;
+    init_output_writer(&out, STDOUT_FILENO, format);
+    Session session;
+    init_session(&session);
+    char *line = 0;
+    size_t size = 0;
+    while (getline(&line, &size, stdin) >= 0) {
+        answer_session_line(&session, index, line, threads, 0, &out);
+        if (flush_output(&out) != 0) {
+            break;
+        }
+    }
+    free(line);
+    free_session(&session);
+    free_output_writer(&out);
+    close_word_index(index);
+    return 0;
+}
+
+/* static WordleArguments parse_session_query(const Session *session,
+*        char *line)
+* -----------------------------------------------
+* Parses a query of a session. Once the session has a word length, a query
+* without -len is parsed as if it had been given that length, and a query
+* with a different -len is rejected.
+*
+* session: the session
+* line: the query, split up in place
+*
+* Returns: the parsed query
+* Errors: status is set as for parse_query_line(), or to 1 if the query is
+* for another word length than the session
+*/
+static WordleArguments parse_session_query(const Session *session,
+        char *line)
+{
+    char *withLen = 0;
+    if (session->turnCount) {
+        withLen = malloc(strlen(line) + 16);
+        sprintf(withLen, "-len %d %s", session->len, line);
+    }
+    WordleArguments args = parse_query_line(line);
+    if (withLen && !args.lenFlag) {
+        args = parse_query_line(withLen);
+    }
+    free(withLen);
+    if (!args.status && session->turnCount && args.len != session->len) {
+        args.status = 1;
+    }
+    return args;
+}
+
+/* static int narrow_turn(Session *session, int turn, int threads)
+* -----------------------------------------------
+* Works out the words still possible after a turn: the first turn scans the
+* bucket, later turns filter the words left by the turn before
+*
+* session: the session
+* turn: index of the turn, whose args are set
+* threads: number of threads the first turn scans with
+*
+* Returns: the number of words still possible
+* Errors: -
+*/
+static int narrow_turn(Session *session, int turn, int threads)
+{
+    const WordleArguments *args = &session->turns[turn].args;
+    CandidateList *candidates = &session->turns[turn].candidates;
+    const WordBucket *bucket = get_word_bucket(session->index, session->len);
+    const char *patternString = args->patternFlag ? args->patternString : 0;
+    const char *withString = args->withFlag ? args->withString : "";
+    const char *withoutString = args->withoutFlag ? args->withoutString : "";
+    const FeedbackConstraints *feedback = args->feedbackFlag
+            ? &args->feedback : 0;
+    if (turn == 0) {
+        return scan_bucket(bucket, patternString, withString, withoutString,
+                feedback, threads, 0, candidates);
+    }
+    ScanFilter filter;
+    compile_scan_filter(bucket, patternString, withString, withoutString,
+            feedback, &filter);
+    return narrow_candidates(&session->turns[turn - 1].candidates, &filter,
+            candidates);
+}
+
+/* static int print_turn(const SessionTurn *turn,
+*        const WordleArguments *args, OutputWriter *out)
+* -----------------------------------------------
+* Prints the words still possible after a turn, ordered as the query asks.
+* The turn's own list stays in bucket order for the turns after it.
+*
+* turn: the turn
+* args: the parsed query
+* out: where the words are printed
+*
+* Returns: 0 if there is at least one word, 4 otherwise
+* Errors: -
+*/
+static int print_turn(const SessionTurn *turn, const WordleArguments *args,
+        OutputWriter *out)
+{
+    CandidateList shown;
+    shown.bucket = turn->candidates.bucket;
+    shown.count = turn->candidates.count;
+    init_arena(&shown.arena);
+    shown.ids = arena_alloc(&shown.arena, shown.count * sizeof(uint32_t));
+    memcpy(shown.ids, turn->candidates.ids, shown.count * sizeof(uint32_t));
+    int status = print_candidates(&shown, args, out);
+    free_candidates(&shown);
+    return status;
+}
+
+/* static void drop_turns(Session *session, int turnCount)
+* -----------------------------------------------
+* Undoes the most recent turns of a session, forgetting its word length if
+* none are left
+*
+* session: the session
+* turnCount: number of turns to keep
+*
+* Returns: -
+* Errors: -
+*/
+static void drop_turns(Session *session, int turnCount)
+{
+    while (session->turnCount > turnCount) {
+        free_candidates(&session->turns[--session->turnCount].candidates);
+    }
+    if (session->turnCount == 0) {
+        session->len = 0;
+        session->index = 0;
+    }
+}
@@ -0,0 +1,50 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <stdint.h>
+#include "wordindex.h"
+#include "scan.h"
+#include "query.h"
+#include "output.h"
+
+// Lines of a session that are commands rather than queries
+#define SESSION_START 1
+#define SESSION_UNDO 2
+#define SESSION_RESET 3
+
+/*
+* Struct Definitions
+*/
+// One query of a session and the words still possible after it and every
+// earlier query
+typedef struct {
+    WordleArguments args;
+    CandidateList candidates;
+} SessionTurn;
+
+// The turns of a game so far, most recent last. generation is free for the
+// caller to record which version of the index the candidates refer to.
+typedef struct {
+    const WordIndex *index;
+    uint64_t generation;
+    int len;
+    SessionTurn *turns;
+    int turnCount;
+    int capacity;
+} Session;
+
+/*
+* Function Prototypes
+*/
+void init_session(Session *session);
+int get_session_command(const char *line);
+void answer_session_line(Session *session, const WordIndex *index,
+        char *line, int threads, int maxThreads, OutputWriter *out);
+void rebind_session(Session *session, const WordIndex *index, int threads);
+void free_session(Session *session);
+int run_session(int threads, int format);
+
+#endif
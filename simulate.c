@@ -0,0 +1,595 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "simulate.h"
+#include "wordindex.h"
+#include "scan.h"
+#include "score.h"
+#include "entropy.h"
+#include "feedback.h"
+#include "tree.h"
+#include "bitsetindex.h"
+#include "parallel.h"
+#include "stats.h"
+
+// -simulate plays a game for every word of a length as the answer, picking
+// each guess the way a query would rank the words still possible and
+// narrowing them with the feedback the guess gets, through the same scan
+// filter a -feedback query compiles. Games that have had the same feedback
+// so far have the same words left, so they are played together: each set
+// of words picks one guess, and is split into the sets each feedback
+// leaves. That keeps the number of guesses picked (the expensive part with
+// -entropy) to one per set rather than one per game and turn.
+//
+// The first guess is picked once, with every thread. The sets its feedback
+// leaves are then handed out to the threads, which play them to the end on
+// their own: each thread keeps the word IDs of the sets it is working on in
+// a stack of its own, along with its scratch buffers and counts, so nothing
+// is shared until the counts are added up at the end.
+
+// Games still going after this many guesses are given up
+#define MAX_SIMULATED_GUESSES 32
+// Games solved in more guesses than this are failures
+#define MAX_WORDLE_GUESSES 6
+// Word IDs a thread's stack has room for before it grows
+#define INITIAL_STACK 4096
+
+/*
+* Struct Definitions
+*/
+// What one thread works with. stack holds the word IDs of the sets being
+// played, from the full bucket at the bottom up to the current set, and
+// the feedback codes each set's guess got; top is where the next set goes.
+typedef struct {
+    uint32_t *stack;
+    size_t top;
+    size_t capacity;
+    uint8_t *seen;
+    double *entropies;
+    uint64_t *isAnswer;
+    uint64_t solved[MAX_SIMULATED_GUESSES + 1];
+    uint64_t unsolved;
+} SimulationThread;
+
+typedef struct {
+    const WordBucket *bucket;
+    int strategy;
+    const DecisionTree *tree;
+    uint32_t solvedCode;
+    const char *firstGuess;
+    uint32_t *firstCodes;
+    int firstCodeCount;
+    uint32_t next;
+    SimulationThread *threads;
+} Simulation;
+
+/*
+* Function Prototypes
+*/
+static void init_simulation_thread(const Simulation *simulation,
+        SimulationThread *thread);
+static void free_simulation_thread(SimulationThread *thread);
+static void reserve_stack(SimulationThread *thread, size_t count);
+static void play_first_splits(int chunk, void *context);
+static void play_set(const Simulation *simulation, SimulationThread *thread,
+        size_t offset, int count, int guessCount, int node);
+static void play_split(const Simulation *simulation,
+        SimulationThread *thread, size_t offset, int count,
+        const char *guess, uint32_t code, int guessCount, int node);
+static int split_codes(const Simulation *simulation,
+        SimulationThread *thread, size_t offset, int count,
+        const char *guess);
+static const char *pick_guess(const Simulation *simulation,
+        SimulationThread *thread, const uint32_t *ids, int count, int node,
+        int threads);
+static const char *pick_alphabetical(const WordBucket *bucket,
+        const uint32_t *ids, int count);
+static const char *pick_best_score(const WordBucket *bucket,
+        const uint32_t *ids, int count);
+static const char *pick_entropy(const WordBucket *bucket,
+        SimulationThread *thread, const uint32_t *ids, int count,
+        int threads);
+static void report_simulation(const Simulation *simulation, int threadCount,
+        uint64_t elapsedNs);
+
+/* int run_simulation(int len, int strategy, int threads)
+* -----------------------------------------------
+* Plays every word of a length as the answer of a game and prints how many
+* guesses the games took, the failure rate and how many games were played
+* per second
+*
+* len: the word length
+* strategy: how guesses are picked (one of the SIMULATE_ constants)
+* threads: maximum number of threads to play with
+*
+* Returns: 0 if games were played, 4 if there are no words of the length,
+*          or TREE_ERROR_STATUS if the strategy is SIMULATE_TREE and no
+*          tree has been built for the dictionary
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+int run_simulation(int len, int strategy, int threads)
+{
+    DecisionTree tree;
+    if (strategy == SIMULATE_TREE && !open_decision_tree(len, &tree)) {
+        fprintf(stderr, "wordle-helper: no decision tree for length %d, "
+                "build one with -buildtree\n", len);
+        return TREE_ERROR_STATUS;
+    }
+    uint64_t start = get_monotonic_ns();
+    WordIndex *index = open_word_index(len);
+    Simulation simulation;
+    memset(&simulation, 0, sizeof(simulation));
+    simulation.bucket = get_word_bucket(index, len);
+    simulation.strategy = strategy;
+    simulation.tree = strategy == SIMULATE_TREE ? &tree : 0;
+    for (int pos = 0; pos < len; pos++) {
+        simulation.solvedCode = simulation.solvedCode * 3 + 2;
+    }
+    int status = 4;
+    int count = simulation.bucket->count;
+    if (count && (!simulation.tree || tree.nodeCount)) {
+        simulation.threads = malloc(threads * sizeof(SimulationThread));
+        for (int i = 0; i < threads; i++) {
+            init_simulation_thread(&simulation, &simulation.threads[i]);
+        }
+        SimulationThread *first = &simulation.threads[0];
+        simulation.firstGuess = pick_guess(&simulation, first, first->stack,
+                count, 0, threads);
+        simulation.firstCodeCount = split_codes(&simulation, first, 0, count,
+                simulation.firstGuess);
+        simulation.firstCodes = malloc(simulation.firstCodeCount
+                * sizeof(uint32_t));
+        memcpy(simulation.firstCodes, first->stack + count,
+                simulation.firstCodeCount * sizeof(uint32_t));
+        int chunkCount = simulation.firstCodeCount < threads
+                ? simulation.firstCodeCount : threads;
+        run_parallel(chunkCount, play_first_splits, &simulation);
+        report_simulation(&simulation, threads, get_monotonic_ns() - start);
+        for (int i = 0; i < threads; i++) {
+            free_simulation_thread(&simulation.threads[i]);
+        }
+        free(simulation.threads);
+        free(simulation.firstCodes);
+        status = 0;
+    }
+    if (simulation.tree) {
+        close_decision_tree(&tree);
+    }
+    close_word_index(index);
+    return status;
+}
+
+/* static void init_simulation_thread(const Simulation *simulation,
+*        SimulationThread *thread)
+* -----------------------------------------------
+* Sets up the buffers of a thread, with every word of the bucket at the
+* bottom of its stack
+*
+* simulation: the simulation
+* thread: the thread's state
+*
+* Returns: -
+* Errors: -
+*/
+static void init_simulation_thread(const Simulation *simulation,
+        SimulationThread *thread)
+{
+    const WordBucket *bucket = simulation->bucket;
+    memset(thread, 0, sizeof(*thread));
+    reserve_stack(thread, bucket->count);
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        thread->stack[i] = i;
+    }
+    thread->top = bucket->count;
+    thread->seen = calloc(simulation->solvedCode + 1, sizeof(uint8_t));
+    if (simulation->strategy == SIMULATE_ENTROPY) {
+        size_t blocks = get_bitset_words(bucket->count);
+        thread->entropies = malloc(bucket->count * sizeof(double));
+        thread->isAnswer = calloc(blocks, sizeof(uint64_t));
+    }
+}
+
+/* static void free_simulation_thread(SimulationThread *thread)
+* -----------------------------------------------
+* Releases the buffers of a thread
+*
+* thread: the thread's state
+*
+* Returns: -
+* Errors: -
+*/
+static void free_simulation_thread(SimulationThread *thread)
+{
+    free(thread->stack);
+    free(thread->seen);
+    free(thread->entropies);
+    free(thread->isAnswer);
+}
+
+/* static void reserve_stack(SimulationThread *thread, size_t count)
+* -----------------------------------------------
+* Makes room for count more entries above the top of a thread's stack.
+* Growing the stack moves it, so sets on it are referred to by offset.
+*
+* thread: the thread's state
+* count: number of entries needed
+*
+* Returns: -
+* Errors: -
+*/
+static void reserve_stack(SimulationThread *thread, size_t count)
+{
+    if (thread->top + count <= thread->capacity) {
+        return;
+    }
+    size_t capacity = thread->capacity ? thread->capacity : INITIAL_STACK;
+    while (capacity < thread->top + count) {
+        capacity *= 2;
+    }
+    thread->stack = realloc(thread->stack, capacity * sizeof(uint32_t));
+    thread->capacity = capacity;
+}
+
+/* static void play_first_splits(int chunk, void *context)
+* -----------------------------------------------
+* Thread body of run_simulation(): plays the sets of words left by the
+* feedback to the first guess until none are left
+*
+* chunk: index of the thread
+* context: the Simulation
+*
+* Returns: -
+* Errors: -
+*/
+static void play_first_splits(int chunk, void *context)
+{
+    Simulation *simulation = context;
+    SimulationThread *thread = &simulation->threads[chunk];
+    int count = simulation->bucket->count;
+    while (1) {
+        uint32_t split = __atomic_fetch_add(&simulation->next, 1,
+                __ATOMIC_RELAXED);
+        if (split >= (uint32_t) simulation->firstCodeCount) {
+            break;
+        }
+        play_split(simulation, thread, 0, count, simulation->firstGuess,
+                simulation->firstCodes[split], 1, 0);
+    }
+}
+
+/* static void play_set(const Simulation *simulation,
+*        SimulationThread *thread, size_t offset, int count, int guessCount,
+*        int node)
+* -----------------------------------------------
+* Plays the games whose answer is one of a set of words to the end
+*
+* simulation: the simulation
+* thread: the thread's state
+* offset: where the word IDs of the set are on the thread's stack, in
+*         bucket order
+* count: number of words in the set (greater than 0)
+* guessCount: guesses made so far
+* node: the tree node of the set, if the strategy is SIMULATE_TREE
+*
+* Returns: -
+* Errors: -
+*/
+static void play_set(const Simulation *simulation, SimulationThread *thread,
+        size_t offset, int count, int guessCount, int node)
+{
+    if (guessCount == MAX_SIMULATED_GUESSES) {
+        thread->unsolved += count;
+        return;
+    }
+    const char *guess = pick_guess(simulation, thread,
+            thread->stack + offset, count, node, 1);
+    size_t codes = thread->top;
+    int codeCount = split_codes(simulation, thread, offset, count, guess);
+    thread->top += codeCount;
+    for (int i = 0; i < codeCount; i++) {
+        play_split(simulation, thread, offset, count, guess,
+                thread->stack[codes + i], guessCount + 1, node);
+    }
+    thread->top = codes;
+}
+
+/* static void play_split(const Simulation *simulation,
+*        SimulationThread *thread, size_t offset, int count,
+*        const char *guess, uint32_t code, int guessCount, int node)
+* -----------------------------------------------
+* Narrows a set of words down to those that get a feedback to a guess and
+* plays their games on
+*
+* simulation: the simulation
+* thread: the thread's state
+* offset: where the word IDs of the set are on the thread's stack
+* count: number of words in the set
+* guess: the guess
+* code: the feedback code (see entropy.c) at least one word of the set gets
+* guessCount: guesses made so far, including this one
+* node: the tree node the guess was taken from, if any
+*
+* Returns: -
+* Errors: -
+*/
+static void play_split(const Simulation *simulation,
+        SimulationThread *thread, size_t offset, int count,
+        const char *guess, uint32_t code, int guessCount, int node)
+{
+    const WordBucket *bucket = simulation->bucket;
+    int len = bucket->len;
+    char feedbackArg[2 * MAX_LEN + 2];
+    memcpy(feedbackArg, guess, len);
+    feedbackArg[len] = ':';
+    for (int pos = 0, marks = code; pos < len; pos++, marks /= 3) {
+        feedbackArg[len + 1 + pos] = "BYG"[marks % 3];
+    }
+    feedbackArg[2 * len + 1] = '\0';
+    FeedbackConstraints feedback;
+    ScanFilter filter;
+    init_feedback_constraints(&feedback);
+    add_feedback(&feedback, feedbackArg);
+    compile_scan_filter(bucket, 0, "", "", &feedback, &filter);
+    size_t split = thread->top;
+    reserve_stack(thread, count);
+    int splitCount = filter_candidate_ids(bucket, &filter,
+            thread->stack + offset, count, thread->stack + split);
+    if (code == simulation->solvedCode) {
+        thread->solved[guessCount] += splitCount;
+        return;
+    }
+    int child = simulation->tree
+            ? follow_decision_tree(simulation->tree, node, code) : 0;
+    if (child < 0) {
+        // Only a tree built for other words can miss a feedback
+        thread->unsolved += splitCount;
+        return;
+    }
+    thread->top += splitCount;
+    play_set(simulation, thread, split, splitCount, guessCount, child);
+    thread->top = split;
+}
+
+/* static int split_codes(const Simulation *simulation,
+*        SimulationThread *thread, size_t offset, int count,
+*        const char *guess)
+* -----------------------------------------------
+* Works out the different feedback codes a guess gets over a set of words
+*
+* simulation: the simulation
+* thread: the thread's state
+* offset: where the word IDs of the set are on the thread's stack
+* count: number of words in the set
+* guess: the guess
+*
+* Returns: the number of different codes, which are left above the top of
+*          the thread's stack
+* Errors: -
+*/
+static int split_codes(const Simulation *simulation,
+        SimulationThread *thread, size_t offset, int count,
+        const char *guess)
+{
+    const WordBucket *bucket = simulation->bucket;
+    int stride = bucket->len + 1;
+    reserve_stack(thread, count);
+    uint32_t *codes = thread->stack + thread->top;
+    int codeCount = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t code = get_feedback_code(guess, bucket->words
+                + (size_t) thread->stack[offset + i] * stride, bucket->len);
+        if (!thread->seen[code]) {
+            thread->seen[code] = 1;
+            codes[codeCount++] = code;
+        }
+    }
+    for (int i = 0; i < codeCount; i++) {
+        thread->seen[codes[i]] = 0;
+    }
+    return codeCount;
+}
+
+/* static const char *pick_guess(const Simulation *simulation,
+*        SimulationThread *thread, const uint32_t *ids, int count, int node,
+*        int threads)
+* -----------------------------------------------
+* Picks the guess for a set of words as the simulation's strategy would
+*
+* simulation: the simulation
+* thread: the thread's state
+* ids: the word IDs of the set, in bucket order
+* count: number of words in the set (greater than 0)
+* node: the tree node of the set, if the strategy is SIMULATE_TREE
+* threads: maximum number of threads to score -entropy guesses with
+*
+* Returns: the NUL terminated guess
+* Errors: -
+*/
+static const char *pick_guess(const Simulation *simulation,
+        SimulationThread *thread, const uint32_t *ids, int count, int node,
+        int threads)
+{
+    const WordBucket *bucket = simulation->bucket;
+    switch (simulation->strategy) {
+        case SIMULATE_ALPHA:
+            return pick_alphabetical(bucket, ids, count);
+        case SIMULATE_BEST:
+            return pick_best_score(bucket, ids, count);
+        case SIMULATE_ENTROPY:
+            return pick_entropy(bucket, thread, ids, count, threads);
+        case SIMULATE_TREE:
+            return get_tree_guess(simulation->tree, node);
+        default:
+            return bucket->words + (size_t) ids[0] * (bucket->len + 1);
+    }
+}
+
+/* static const char *pick_alphabetical(const WordBucket *bucket,
+*        const uint32_t *ids, int count)
+* -----------------------------------------------
+* Picks the word of a set that -alpha prints first
+*
+* bucket: the bucket holding the words
+* ids: the word IDs of the set
+* count: number of words in the set (greater than 0)
+*
+* Returns: the alphabetically first word
+* Errors: -
+*/
+static const char *pick_alphabetical(const WordBucket *bucket,
+        const uint32_t *ids, int count)
+{
+    int stride = bucket->len + 1;
+    const char *first = bucket->words + (size_t) ids[0] * stride;
+    for (int i = 1; i < count; i++) {
+        const char *word = bucket->words + (size_t) ids[i] * stride;
+        if (strcmp(word, first) < 0) {
+            first = word;
+        }
+    }
+    return first;
+}
+
+/* static const char *pick_best_score(const WordBucket *bucket,
+*        const uint32_t *ids, int count)
+* -----------------------------------------------
+* Picks the word of a set that -best prints first: the highest score
+* against the set (see score_candidates()), alphabetically first among
+* equal scores
+*
+* bucket: the bucket holding the words
+* ids: the word IDs of the set
+* count: number of words in the set (greater than 0)
+*
+* Returns: the best scoring word
+* Errors: -
+*/
+static const char *pick_best_score(const WordBucket *bucket,
+        const uint32_t *ids, int count)
+{
+    int stride = bucket->len + 1;
+    LetterStats stats;
+    ScoreTable table;
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < count; i++) {
+        add_letter_stats(&stats, bucket->words + (size_t) ids[i] * stride,
+                bucket->masks[ids[i]], bucket->len);
+    }
+    build_score_table(&stats, bucket->len, &table);
+    const char *best = 0;
+    uint32_t bestScore = 0;
+    for (int i = 0; i < count; i++) {
+        const char *word = bucket->words + (size_t) ids[i] * stride;
+        uint32_t score = score_word(&table, word, bucket->masks[ids[i]]);
+        if (!best || score > bestScore
+                || (score == bestScore && strcmp(word, best) < 0)) {
+            best = word;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+/* static const char *pick_entropy(const WordBucket *bucket,
+*        SimulationThread *thread, const uint32_t *ids, int count,
+*        int threads)
+* -----------------------------------------------
+* Picks the guess -entropy ranks first for a set of words: the word of the
+* bucket whose feedback tells the most about the set, preferring words of
+* the set and then alphabetical order among equals. With one or two words
+* left, guessing the alphabetically first of them is always such a guess.
+*
+* bucket: the bucket holding the words
+* thread: the thread's state
+* ids: the word IDs of the set, in bucket order
+* count: number of words in the set (greater than 0)
+* threads: maximum number of threads to score the guesses with
+*
+* Returns: the highest ranked guess
+* Errors: -
+*/
+static const char *pick_entropy(const WordBucket *bucket,
+        SimulationThread *thread, const uint32_t *ids, int count,
+        int threads)
+{
+    if (count <= 2) {
+        return pick_alphabetical(bucket, ids, count);
+    }
+    int stride = bucket->len + 1;
+    score_guess_entropies(bucket, 0, bucket->count, ids, count, threads,
+            thread->entropies);
+    for (int i = 0; i < count; i++) {
+        thread->isAnswer[ids[i] / 64] |= 1ull << (ids[i] % 64);
+    }
+    uint32_t best = 0;
+    int bestIsAnswer = thread->isAnswer[0] & 1;
+    for (uint32_t i = 1; i < bucket->count; i++) {
+        double entropy = thread->entropies[i];
+        double bestEntropy = thread->entropies[best];
+        int isAnswer = (thread->isAnswer[i / 64] >> (i % 64)) & 1;
+        if (entropy > bestEntropy || (entropy == bestEntropy
+                && (isAnswer > bestIsAnswer || (isAnswer == bestIsAnswer
+                && strcmp(bucket->words + (size_t) i * stride,
+                bucket->words + (size_t) best * stride) < 0)))) {
+            best = i;
+            bestIsAnswer = isAnswer;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        thread->isAnswer[ids[i] / 64] = 0;
+    }
+    return bucket->words + (size_t) best * stride;
+}
+
+/* static void report_simulation(const Simulation *simulation,
+*        int threadCount, uint64_t elapsedNs)
+* -----------------------------------------------
+* Adds up the counts of the threads and prints them
+*
+* simulation: the simulation, played to the end
+* threadCount: number of thread states
+* elapsedNs: how long the simulation took, loading the index included
+*
+* Returns: -
+* Errors: -
+*/
+static void report_simulation(const Simulation *simulation, int threadCount,
+        uint64_t elapsedNs)
+{
+    static const char *const names[] = {"first", "alpha", "best", "entropy",
+            "tree"};
+    uint64_t solved[MAX_SIMULATED_GUESSES + 1];
+    uint64_t unsolved = 0, slow = 0, games = 0, guesses = 0;
+    memset(solved, 0, sizeof(solved));
+    for (int i = 0; i < threadCount; i++) {
+        for (int n = 1; n <= MAX_SIMULATED_GUESSES; n++) {
+            solved[n] += simulation->threads[i].solved[n];
+        }
+        unsolved += simulation->threads[i].unsolved;
+    }
+    for (int n = 1; n <= MAX_SIMULATED_GUESSES; n++) {
+        games += solved[n];
+        guesses += solved[n] * n;
+        if (n > MAX_WORDLE_GUESSES) {
+            slow += solved[n];
+        }
+    }
+    double seconds = elapsedNs / 1e9;
+    printf("strategy: %s\n", names[simulation->strategy]);
+    printf("first guess: %s\n", simulation->firstGuess);
+    printf("games: %lu\n", (unsigned long) (games + unsolved));
+    for (int n = 1; n <= MAX_WORDLE_GUESSES; n++) {
+        printf("solved in %d: %lu\n", n, (unsigned long) solved[n]);
+    }
+    printf("solved in more than %d: %lu\n", MAX_WORDLE_GUESSES,
+            (unsigned long) slow);
+    printf("unsolved: %lu\n", (unsigned long) unsolved);
+    printf("failure rate: %.3f%%\n",
+            100.0 * (slow + unsolved) / (games + unsolved));
+    printf("average guesses: %.3f\n", games ? (double) guesses / games : 0);
+    printf("time: %.3f ms\n", seconds * 1e3);
+    printf("words per second: %.0f\n", (games + unsolved) / seconds);
+}
@@ -0,0 +1,20 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef SIMULATE_H
+#define SIMULATE_H
+
+// How -simulate picks each guess: the first word the query would print
+// without any ordering, or the first with -alpha, -best, -entropy or -tree
+#define SIMULATE_FIRST 0
+#define SIMULATE_ALPHA 1
+#define SIMULATE_BEST 2
+#define SIMULATE_ENTROPY 3
+#define SIMULATE_TREE 4
+
+/*
+* Function Prototypes
+*/
+int run_simulation(int len, int strategy, int threads);
+
+#endif
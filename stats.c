@@ -0,0 +1,309 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "stats.h"
+#include "lettermask.h"
+
+#define NS_PER_MS 1000000.0
+
+/*
+* Function Prototypes
+*/
+static int matches_feedback(const LetterRequirements *requirements,
+        const WordBucket *bucket, uint32_t i);
+static long get_peak_rss_kb(void);
+static void report_predicate_order(const PredicatePlan *plan, int format,
+        FILE *stream);
+
+/* uint64_t get_monotonic_ns(void)
+* -----------------------------------------------
+* Reads the monotonic clock
+*
+* Returns: the time in nanoseconds since an arbitrary starting point
+* Errors: -
+*/
+uint64_t get_monotonic_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+/* void count_filter_rejections(const WordBucket *bucket,
+*        const char *patternString, const char *withString,
+*        const char *withoutString, const FeedbackConstraints *feedback,
+*        QueryStats *stats)
+* -----------------------------------------------
+* Works out how many words of the bucket each argument rejects. The scan
+* applies all of them at once, so this takes a separate pass that applies
+* them one after the other (pattern, -with, -without, then -feedback) and
+* charges each word to the first one it fails.
+*
+* bucket: the scanned bucket
+* patternString: uppercase pattern, or NULL if no pattern was given
+* withString, withoutString: uppercase -with/-without values ("" if unset)
+* feedback: constraints from -feedback, or NULL if none was given
+* stats: the rejection counts and the number of matches (ignoring any
+*        limit) are filled in
+*
+* Returns: -
+* Errors: -
+*/
+void count_filter_rejections(const WordBucket *bucket,
+        const char *patternString, const char *withString,
+        const char *withoutString, const FeedbackConstraints *feedback,
+        QueryStats *stats)
+{
+    LetterRequirements with, without, fromFeedback;
+    compile_letter_requirements(withString, "", &with);
+    compile_letter_requirements("", withoutString, &without);
+    compile_letter_requirements("", "", &fromFeedback);
+    int possible = feedback == 0 || apply_feedback_constraints(feedback, 0,
+            &fromFeedback);
+    int stride = bucket->len + 1;
+    stats->bucketWords = bucket->count;
+    stats->rejectedPattern = stats->rejectedWith = stats->rejectedWithout =
+            stats->rejectedFeedback = 0;
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        const char *word = bucket->words + (size_t) i * stride;
+        int matchesPattern = 1;
+        for (int pos = 0; patternString && pos < bucket->len; pos++) {
+            if (patternString[pos] != '_' && patternString[pos] != word[pos]) {
+                matchesPattern = 0;
+                break;
+            }
+        }
+        if (!matchesPattern) {
+            stats->rejectedPattern++;
+        } else if (!matches_letter_requirements(&with, bucket->masks[i],
+                &bucket->counts[i], word)) {
+            stats->rejectedWith++;
+        } else if (!matches_letter_requirements(&without, bucket->masks[i],
+                &bucket->counts[i], word)) {
+            stats->rejectedWithout++;
+        } else if (feedback && (!possible
+                || !matches_feedback(&fromFeedback, bucket, i))) {
+            stats->rejectedFeedback++;
+        }
+    }
+    stats->matches = bucket->count - stats->rejectedPattern
+            - stats->rejectedWith - stats->rejectedWithout
+            - stats->rejectedFeedback;
+}
+
+/* void report_stats(const QueryStats *stats, const WordIndex *index,
+*        int format, FILE *stream)
+* -----------------------------------------------
+* Prints the statistics of a query, as "name: value" lines or as a single
+* JSON object
+*
+* stats: the query's statistics
+* index: the index the query ran against
+* format: STATS_TEXT or STATS_JSON
+* stream: where the statistics are printed
+*
+* Returns: -
+* Errors: -
+*/
+void report_stats(const QueryStats *stats, const WordIndex *index,
+        int format, FILE *stream)
+{
+    const IndexCounters *counters = &index->counters;
+    const IndexTimings *timings = &index->timings;
+    const ResultCacheCounters *cacheCounters = &stats->cacheCounters;
+    static const char *const cacheLookups[] = {"off", "miss", "hit",
+            "subsumed"};
+    double totalMs = (get_monotonic_ns() - stats->startNs) / NS_PER_MS;
+    long peakRss = get_peak_rss_kb();
+    if (format == STATS_JSON) {
+        fprintf(stream, "{\"stages_ms\": {\"parse\": %.3f, "
+                "\"index_read\": %.3f, \"index_build\": %.3f, "
+                "\"index_write\": %.3f, \"scan\": %.3f, \"sort\": %.3f, "
+                "\"output\": %.3f, \"total\": %.3f}, ",
+                stats->parseNs / NS_PER_MS, timings->readNs / NS_PER_MS,
+                timings->buildNs / NS_PER_MS, timings->writeNs / NS_PER_MS,
+                stats->scanNs / NS_PER_MS, stats->sortNs / NS_PER_MS,
+                stats->outputNs / NS_PER_MS, totalMs);
+        fprintf(stream, "\"index\": {\"from_cache\": %s, "
+                "\"words_read\": %lu, \"rejected_length\": %lu, "
+                "\"rejected_non_alpha\": %lu, \"duplicates\": %lu}, ",
+                index->fromCache ? "true" : "false",
+                (unsigned long) counters->wordsRead,
+                (unsigned long) counters->rejectedLength,
+                (unsigned long) counters->rejectedNonAlpha,
+                (unsigned long) counters->duplicates);
+        fprintf(stream, "\"filter\": {\"bucket_words\": %lu, "
+                "\"rejected_pattern\": %lu, \"rejected_with\": %lu, "
+                "\"rejected_without\": %lu, \"rejected_feedback\": %lu, "
+                "\"matches\": %lu}, ",
+                (unsigned long) stats->bucketWords,
+                (unsigned long) stats->rejectedPattern,
+                (unsigned long) stats->rejectedWith,
+                (unsigned long) stats->rejectedWithout,
+                (unsigned long) stats->rejectedFeedback,
+                (unsigned long) stats->matches);
+        report_predicate_order(&stats->predicates, format, stream);
+        fprintf(stream, "\"result_cache\": {\"lookup\": \"%s\"",
+                cacheLookups[stats->cacheLookup]);
+        if (stats->cacheLookup != RESULT_OFF) {
+            fprintf(stream, ", \"hits\": %lu, \"subsumed_hits\": %lu, "
+                    "\"misses\": %lu, \"evictions\": %lu, "
+                    "\"entries\": %lu, \"bytes\": %lu",
+                    (unsigned long) cacheCounters->hits,
+                    (unsigned long) cacheCounters->subsumedHits,
+                    (unsigned long) cacheCounters->misses,
+                    (unsigned long) cacheCounters->evictions,
+                    (unsigned long) cacheCounters->entries,
+                    (unsigned long) cacheCounters->bytes);
+        }
+        fprintf(stream, "}, ");
+        fprintf(stream, "\"allocations\": {\"arena_blocks\": %lu}, "
+                "\"peak_rss_kb\": %ld}\n",
+                (unsigned long) stats->arenaBlocks, peakRss);
+        return;
+    }
+    fprintf(stream, "stage parse: %.3f ms\n", stats->parseNs / NS_PER_MS);
+    fprintf(stream, "stage index read: %.3f ms\n",
+            timings->readNs / NS_PER_MS);
+    fprintf(stream, "stage index build: %.3f ms\n",
+            timings->buildNs / NS_PER_MS);
+    fprintf(stream, "stage index write: %.3f ms\n",
+            timings->writeNs / NS_PER_MS);
+    fprintf(stream, "stage scan: %.3f ms\n", stats->scanNs / NS_PER_MS);
+    fprintf(stream, "stage sort: %.3f ms\n", stats->sortNs / NS_PER_MS);
+    fprintf(stream, "stage output: %.3f ms\n", stats->outputNs / NS_PER_MS);
+    fprintf(stream, "total: %.3f ms\n", totalMs);
+    fprintf(stream, "index from cache: %s\n", index->fromCache ? "yes" : "no");
+    fprintf(stream, "words read: %lu\n", (unsigned long) counters->wordsRead);
+    fprintf(stream, "rejected by length: %lu\n",
+            (unsigned long) counters->rejectedLength);
+    fprintf(stream, "rejected as non-alpha: %lu\n",
+            (unsigned long) counters->rejectedNonAlpha);
+    fprintf(stream, "duplicates: %lu\n", (unsigned long) counters->duplicates);
+    fprintf(stream, "bucket words: %lu\n", (unsigned long) stats->bucketWords);
+    fprintf(stream, "rejected by pattern: %lu\n",
+            (unsigned long) stats->rejectedPattern);
+    fprintf(stream, "rejected by -with: %lu\n",
+            (unsigned long) stats->rejectedWith);
+    fprintf(stream, "rejected by -without: %lu\n",
+            (unsigned long) stats->rejectedWithout);
+    fprintf(stream, "rejected by -feedback: %lu\n",
+            (unsigned long) stats->rejectedFeedback);
+    fprintf(stream, "matches: %lu\n", (unsigned long) stats->matches);
+    report_predicate_order(&stats->predicates, format, stream);
+    fprintf(stream, "arena blocks: %lu\n", (unsigned long) stats->arenaBlocks);
+    fprintf(stream, "result cache: %s\n", cacheLookups[stats->cacheLookup]);
+    if (stats->cacheLookup != RESULT_OFF) {
+        fprintf(stream, "result cache hits: %lu\n",
+                (unsigned long) cacheCounters->hits);
+        fprintf(stream, "result cache subsumed hits: %lu\n",
+                (unsigned long) cacheCounters->subsumedHits);
+        fprintf(stream, "result cache misses: %lu\n",
+                (unsigned long) cacheCounters->misses);
+        fprintf(stream, "result cache evictions: %lu\n",
+                (unsigned long) cacheCounters->evictions);
+        fprintf(stream, "result cache entries: %lu\n",
+                (unsigned long) cacheCounters->entries);
+        fprintf(stream, "result cache bytes: %lu\n",
+                (unsigned long) cacheCounters->bytes);
+    }
+    fprintf(stream, "peak RSS: %ld KB\n", peakRss);
+}
+
+/* static int matches_feedback(const LetterRequirements *requirements,
+*        const WordBucket *bucket, uint32_t i)
+* -----------------------------------------------
+* Checks a word against requirements that only hold feedback constraints
+*
+* requirements: the feedback applied to empty requirements
+* bucket: the bucket holding the word
+* i: ID of the word
+*
+* Returns: 1 if the word satisfies the feedback, 0 otherwise
+* Errors: -
+*/
+static int matches_feedback(const LetterRequirements *requirements,
+        const WordBucket *bucket, uint32_t i)
+{
+    const char *word = bucket->words + (size_t) i * (bucket->len + 1);
+    for (int pos = 0; pos < bucket->len; pos++) {
+        if ((requirements->fixedAt[pos]
+                && requirements->fixedAt[pos] != word[pos])
+                || (requirements->excludedAt[pos]
+                & (1u << (word[pos] - 'A')))) {
+            return 0;
+        }
+    }
+    return matches_letter_requirements(requirements, bucket->masks[i],
+            &bucket->counts[i], word);
+}
+
+/* static void report_predicate_order(const PredicatePlan *plan, int format,
+*        FILE *stream)
+* -----------------------------------------------
+* Prints the order a scan of the bucket runs the tests of the query in and,
+* if they were sampled, the share of the sampled words passing each. As
+* text this is one "predicate order" line (with "(fixed order)" when the
+* bucket was too small to sample), as JSON a "predicates" member.
+*
+* plan: the tests of the query
+* format: STATS_TEXT or STATS_JSON
+* stream: where the order is printed
+*
+* Returns: -
+* Errors: -
+*/
+static void report_predicate_order(const PredicatePlan *plan, int format,
+        FILE *stream)
+{
+    char name[32];
+    if (format == STATS_JSON) {
+        fprintf(stream, "\"predicates\": {\"sampled_words\": %d, "
+                "\"order\": [", plan->sampleSize);
+    } else {
+        fprintf(stream, "predicate order:");
+    }
+    for (int p = 0; p < plan->count; p++) {
+        const Predicate *predicate = &plan->predicates[p];
+        double passRate = plan->sampleSize
+                ? (double) predicate->passed / plan->sampleSize : 0;
+        format_predicate(predicate, name, sizeof(name));
+        if (format == STATS_JSON) {
+            fprintf(stream, "%s{\"test\": \"%s\"", p ? ", " : "", name);
+            if (plan->sampleSize) {
+                fprintf(stream, ", \"pass_rate\": %.3f", passRate);
+            }
+            fprintf(stream, "}");
+        } else if (plan->sampleSize) {
+            fprintf(stream, "%s %s %.1f%%", p ? "," : "", name,
+                    passRate * 100);
+        } else {
+            fprintf(stream, "%s %s", p ? "," : "", name);
+        }
+    }
+    if (format == STATS_JSON) {
+        fprintf(stream, "]}, ");
+    } else {
+        fprintf(stream, "%s\n", plan->count && !plan->sampleSize
+                ? " (fixed order)" : plan->count ? "" : " none");
+    }
+}
+
+/* static long get_peak_rss_kb(void)
+* -----------------------------------------------
+* Reads the peak resident set size of the process
+*
+* Returns: the peak RSS in kilobytes, or -1 if it is not available
+* Errors: -
+*/
+static long get_peak_rss_kb(void)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss;
+}
@@ -0,0 +1,53 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "wordindex.h"
+#include "feedback.h"
+#include "resultcache.h"
+#include "predicate.h"
+
+#define STATS_TEXT 1
+#define STATS_JSON 2
+
+/*
+* Struct Definition
+*/
+// What one query cost: stage timings (monotonic clock), how the bucket was
+// whittled down to the matches, and the memory it took
+typedef struct {
+    uint64_t startNs;
+    uint64_t parseNs;
+    uint64_t scanNs;
+    uint64_t sortNs;
+    uint64_t outputNs;
+    uint64_t bucketWords;
+    uint64_t rejectedPattern;
+    uint64_t rejectedWith;
+    uint64_t rejectedWithout;
+    uint64_t rejectedFeedback;
+    uint64_t matches;
+    PredicatePlan predicates;
+    size_t arenaBlocks;
+    // What the result cache had for the query (RESULT_OFF without one)
+    int cacheLookup;
+    ResultCacheCounters cacheCounters;
+} QueryStats;
+
+/*
+* Function Prototypes
+*/
+uint64_t get_monotonic_ns(void);
+void count_filter_rejections(const WordBucket *bucket,
+        const char *patternString, const char *withString,
+        const char *withoutString, const FeedbackConstraints *feedback,
+        QueryStats *stats);
+void report_stats(const QueryStats *stats, const WordIndex *index,
+        int format, FILE *stream);
+
+#endif
@@ -0,0 +1,235 @@
+#!/bin/sh
+# Wordle Helper
+# Author: Rohith Kotia Palakirti
+
+# ./clitest.sh wordle-helper serveclient
+#
+# Runs the program on argument lists and batch lines that once went wrong
+# and checks the exit status and output. -serve is reached through
+# serveclient (test/serveclient.c). Exits with 0 if every check passes, 1
+# otherwise.
+
+BIN=$1
+CLIENT=$2
+DIR=$(mktemp -d /tmp/clitest-XXXXXX)
+trap 'rm -rf "$DIR"' EXIT
+printf 'crane\nslate\nabbey\nstore\n' > "$DIR/words.txt"
+export WORDLE_DICTIONARY="$DIR/words.txt"
+export WORDLE_CACHE_DIR=""
+FAILED=0
+
+# expect_status status args...: runs the program, checking its exit status
+expect_status() {
+    expected=$1
+    shift
+    "$BIN" "$@" < /dev/null > /dev/null 2>&1
+    status=$?
+    if [ "$status" -ne "$expected" ]; then
+        echo "wordle-helper $*: exit status $status, expected $expected"
+        FAILED=1
+    fi
+}
+
+# expect_batch expected lines...: runs the lines as a batch, checking the
+# output
+expect_batch() {
+    expected=$1
+    shift
+    output=$(printf '%s\n' "$@" | "$BIN" -batch - 2>&1)
+    if [ "$output" != "$(printf "$expected")" ]; then
+        echo "batch $*: got"
+        echo "$output"
+        FAILED=1
+    fi
+}
+
+# expect_usage mode args...: runs the program, checking it prints the
+# usage of the mode
+expect_usage() {
+    mode=$1
+    shift
+    case $("$BIN" "$@" 2>&1 < /dev/null) in
+        "Usage: wordle-helper $mode"*) ;;
+        *)
+            echo "wordle-helper $*: not the usage of \"$mode\""
+            FAILED=1
+            ;;
+    esac
+}
+
+# expect_output expected args...: runs the program, checking its output
+expect_output() {
+    expected=$1
+    shift
+    output=$("$BIN" "$@" 2>&1 < /dev/null)
+    if [ "$output" != "$(printf "$expected")" ]; then
+        echo "wordle-helper $*: got"
+        echo "$output"
+        FAILED=1
+    fi
+}
+
+# expect_hex expected args...: runs the program on this function's input,
+# checking its output bytes, given in hex (spaces are ignored)
+expect_hex() {
+    expected=$1
+    shift
+    output=$("$BIN" "$@" | od -An -tx1 | tr -d ' \n')
+    if [ "$output" != "$(echo "$expected" | tr -d ' ')" ]; then
+        echo "wordle-helper $*: got $output"
+        FAILED=1
+    fi
+}
+
+USAGE=$("$BIN" -bogus 2>&1)
+
+# A value missing at the end of the arguments
+expect_status 1 -serve
+expect_status 1 -batch
+expect_status 1 -alpha -serve
+expect_status 1 -threads 2 -batch
+expect_status 1 -len
+expect_status 1 -with
+
+# ... and on a batch line
+expect_batch "$USAGE\n1\nCRANE\n0" "-serve" "C____"
+expect_batch "$USAGE\n1\nCRANE\n0" "-batch" "C____"
+
+# Usage errors give the usage of the mode
+expect_usage "[-alpha|-best|-entropy]" -limit x
+expect_usage "-serve socket" -serve
+expect_usage "-batch file" -batch x -alpha
+expect_usage "-session" -session -len 5
+expect_usage "-tree" -tree -with E
+expect_usage "-buildtree" -buildtree -alpha
+expect_usage "-simulate" -simulate -with E
+expect_usage "-boards count" -boards
+
+# Blank batch lines are skipped, not answered with every word
+expect_batch "CRANE\n0\nSLATE\nSTORE\n0" "" "C____" "  " "S____" ""
+
+# A session's last turn answers the query of every turn since -reset,
+# less the one undone, and -undo with no turn to undo answers 1
+output=$(printf '%s\n' "-undo" "____E" "-with S" "-reset" "-with A" \
+        "-without B" "-undo" "-feedback crane:BBYBY" | "$BIN" -session)
+last=$(printf '%s\n' "$output" | awk '/^[0-9]+$/ { last = block; block = "" }
+        !/^[0-9]+$/ { block = block $0 "\n" } END { printf "%s", last }')
+if [ "$(printf '%s\n' "$output" | head -1)" != 1 ] \
+        || [ "$last" != "$("$BIN" -with A -feedback crane:BBYBY)" ]; then
+    echo "session: got"
+    echo "$output"
+    FAILED=1
+fi
+
+# A refinement answered from a cached looser result is the same as one
+# answered by a scan. The bucket is large enough for the looser result to
+# be used.
+awk 'BEGIN {
+    split("a b c d e s t", l, " ")
+    for (i = 0; i < 7 ^ 5; i++) {
+        w = ""
+        for (n = i; length(w) < 5; n = int(n / 7)) {
+            w = w l[n % 7 + 1]
+        }
+        print w
+    }
+}' > "$DIR/many.txt"
+mkdir "$DIR/cache"
+for order in "" -alpha -best; do
+    uncached=$(WORDLE_DICTIONARY="$DIR/many.txt" "$BIN" $order -with D \
+            -without E ABC__)
+    export WORDLE_DICTIONARY="$DIR/many.txt" WORDLE_CACHE_DIR="$DIR/cache" \
+            WORDLE_RESULT_CACHE_MB=8
+    "$BIN" $order ABC__ > /dev/null
+    lookup=$("$BIN" $order -with D -without E -stats json ABC__ 2>&1 \
+            > /dev/null | grep -o '"lookup": "[a-z]*"')
+    cached=$("$BIN" $order -with D -without E ABC__)
+    export WORDLE_DICTIONARY="$DIR/words.txt" WORDLE_CACHE_DIR=""
+    unset WORDLE_RESULT_CACHE_MB
+    if [ "$lookup" != '"lookup": "subsumed"' ] \
+            || [ "$cached" != "$uncached" ]; then
+        echo "cached refinement ($order): $lookup, got"
+        echo "$cached"
+        FAILED=1
+    fi
+    rm -f "$DIR"/cache/*
+done
+
+# CRANE, SLATE and STORE each tell all four words apart; equal guesses go
+# in alphabetical order
+expect_output "CRANE" -entropy -limit 1
+
+# -tree answers from the tree -buildtree keeps in the cache, and a guess
+# the tree does not make answers 4
+export WORDLE_CACHE_DIR="$DIR/cache"
+expect_status 0 -buildtree -len 5
+expect_output "CRANE" -tree
+expect_output "SLATE" -tree -feedback crane:BBGBG
+expect_status 4 -tree -feedback abbey:YBBYB
+export WORDLE_CACHE_DIR=""
+
+# -simulate plays every word of the bucket once and counts each game once
+sum=$("$BIN" -simulate | awk -F': ' '/^games:/ { games = $2 }
+        /^solved in|^unsolved:/ { sum += $2 } END { print games, sum }')
+if [ "$sum" != "4 4" ]; then
+    echo "-simulate: games and solved counts $sum, expected 4 4"
+    FAILED=1
+fi
+
+# -boards takes up to MAX_BOARDS (32) boards
+expect_status 0 -boards 32 -len 5
+expect_usage "-boards count" -boards 33 -len 5
+
+# A query sent to -serve gets the same answer as on the command line
+"$BIN" -serve "$DIR/socket" > /dev/null 2>&1 &
+SERVER=$!
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    [ -S "$DIR/socket" ] && break
+    sleep 0.2
+done
+output=$("$CLIENT" "$DIR/socket" "-with T")
+# ... and "-session" sent again within a session is answered with 1
+session=$("$CLIENT" "$DIR/socket" "-session" "-with T" "-session" "S____")
+kill $SERVER
+wait $SERVER 2> /dev/null
+if [ "$output" != "$(printf 'SLATE\nSTORE\n0')" ]; then
+    echo "-serve: got"
+    echo "$output"
+    FAILED=1
+fi
+if [ "$session" != "$(printf '0\nSLATE\nSTORE\n0\n1\nSLATE\nSTORE\n0')" ]; then
+    echo "-serve session: got"
+    echo "$session"
+    FAILED=1
+fi
+
+# -format nul ends every record with a NUL and -format length puts its
+# length in a byte before it, batch status records included
+expect_hex "534c41544500 53544f524500" -format nul -with T < /dev/null
+expect_hex "05534c415445 0553544f5245" -format length -with T < /dev/null
+printf '%s\n' "-with T -format nul" "-with Q -format length" > "$DIR/lines"
+expect_hex "534c41544500 53544f524500 3000 0134" -batch - < "$DIR/lines"
+
+# -alpha prints a word given several times (in any case) once
+printf 'store\ncrane\nslate\nCrane\ncrane\nabbey\nslate\n' > "$DIR/repeats.txt"
+export WORDLE_DICTIONARY="$DIR/repeats.txt"
+expect_output "ABBEY\nCRANE\nSLATE\nSTORE" -alpha
+export WORDLE_DICTIONARY="$DIR/words.txt"
+
+# -limit K prints the first K words of the full answer, in every order
+export WORDLE_DICTIONARY="$DIR/many.txt"
+for order in "" -alpha -best; do
+    for query in "" "-with D -without E" "A____"; do
+        if [ "$("$BIN" $order -limit 7 $query)" \
+                != "$("$BIN" $order $query | head -7)" ]; then
+            echo "wordle-helper $order -limit 7 $query: not the first 7 words"
+            FAILED=1
+        fi
+    done
+done
+export WORDLE_DICTIONARY="$DIR/words.txt"
+
+if [ "$FAILED" -eq 0 ]; then
+    echo "command line: all checks passed"
+fi
+exit $FAILED
@@ -0,0 +1,398 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "wordle.h"
+#include "wordindex.h"
+#include "bitsetindex.h"
+#include "filterkernel.h"
+#include "predicate.h"
+#include "scan.h"
+#include "entropy.h"
+#include "reference.h"
+
+/*
+* WORDLE_KERNEL=scalar|sse2|avx2 ./kerneltest [-seed seed ]
+*
+* Builds an index of random words of every length from MIN_LEN to MAX_LEN
+* and runs random patterns, -with/-without sets and -feedback through the
+* column kernel picked by WORDLE_KERNEL, the positional bitsets and the
+* candidate filter. Every answer is checked against
+* filter_words_matching_pattern(), filter_words_matching_with(),
+* filter_words_matching_without() and, for feedback, against words giving
+* the same marks under get_feedback_code(). Exits with 0 if they all agree,
+* 1 otherwise.
+*/
+
+// Words are drawn from a few letters so repeated letters are common and
+// most queries match something
+#define TEST_LETTERS "ABDEILNORST"
+// Not a multiple of 64, so the vector kernels and their scalar tail both
+// run
+#define WORDS_PER_LENGTH 3001
+#define QUERIES_PER_LENGTH 300
+#define MAX_QUERY_LETTERS 4
+#define MAX_QUERY_FEEDBACK 2
+
+/*
+* Struct Definitions
+*/
+typedef struct {
+    char pattern[MAX_LEN + 1];
+    int hasPattern;
+    char with[MAX_QUERY_LETTERS + 1];
+    char without[MAX_QUERY_LETTERS + 1];
+    int feedbackCount;
+    char feedback[MAX_QUERY_FEEDBACK][2 * MAX_LEN + 2];
+} TestQuery;
+
+/*
+* Function Prototypes
+*/
+static uint64_t next_random(uint64_t *state);
+static char random_letter(uint64_t *state);
+static int write_test_dictionary(const char *path, uint64_t *state);
+static void make_query(const WordBucket *bucket, uint64_t *state,
+        TestQuery *query);
+static void make_feedback(const WordBucket *bucket, uint64_t *state,
+        char *feedback);
+static int gives_feedback(const char *word, const TestQuery *query);
+static int check_query(const WordBucket *bucket, const TestQuery *query,
+        int ordered);
+static int compare_ids(const char *what, const TestQuery *query,
+        const uint32_t *expected, int expectedCount, const uint32_t *ids,
+        int count);
+
+/* int main(int argc, char *argv[])
+* -----------------------------------------------
+* Runs the test
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings
+*
+* Returns: 0 if every kernel agrees with the reference filters, 1 otherwise
+* Errors: exits with code 1 if the test dictionary cannot be written or
+* indexed
+*/
+int main(int argc, char *argv[])
+{
+    uint64_t state = 1;
+    if (argc == 3 && strcmp(argv[1], "-seed") == 0) {
+        state = strtoull(argv[2], 0, 10) | 1;
+    }
+    char directory[] = "/tmp/kerneltest-XXXXXX";
+    if (mkdtemp(directory) == 0) {
+        perror("kerneltest");
+        return 1;
+    }
+    // The index is built in memory, not cached
+    setenv("WORDLE_CACHE_DIR", "", 1);
+    char path[sizeof(directory) + 16];
+    snprintf(path, sizeof(path), "%s/words.txt", directory);
+    WordIndex *index = 0;
+    if (write_test_dictionary(path, &state)) {
+        index = load_word_index(path, 0);
+    }
+    if (index == 0) {
+        fprintf(stderr, "kerneltest: cannot build the test index\n");
+        unlink(path);
+        rmdir(directory);
+        return 1;
+    }
+    int queries = 0;
+    int failures = 0;
+    for (int len = MIN_LEN; len <= MAX_LEN; len++) {
+        const WordBucket *bucket = get_word_bucket(index, len);
+        for (int q = 0; q < QUERIES_PER_LENGTH; q++) {
+            TestQuery query;
+            make_query(bucket, &state, &query);
+            failures += check_query(bucket, &query, q % 2);
+            queries++;
+        }
+    }
+    printf("kernel %s: %d queries, %d failed\n", get_filter_kernel_name(),
+            queries, failures);
+    close_word_index(index);
+    unlink(path);
+    rmdir(directory);
+    return failures ? 1 : 0;
+}
+
+/* static uint64_t next_random(uint64_t *state)
+* -----------------------------------------------
+* xorshift64* generator, so a seed always gives the same test
+*
+* state: generator state, updated
+*
+* Returns: the next random number
+* Errors: -
+*/
+static uint64_t next_random(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ull;
+}
+
+/* static char random_letter(uint64_t *state)
+* -----------------------------------------------
+* Picks one of TEST_LETTERS
+*
+* state: generator state, updated
+*
+* Returns: the letter
+* Errors: -
+*/
+static char random_letter(uint64_t *state)
+{
+    return TEST_LETTERS[next_random(state) % (sizeof(TEST_LETTERS) - 1)];
+}
+
+/* static int write_test_dictionary(const char *path, uint64_t *state)
+* -----------------------------------------------
+* Writes WORDS_PER_LENGTH random lowercase words of every length
+*
+* path: the file to write
+* state: generator state, updated
+*
+* Returns: 1 on success, 0 if the file cannot be written
+* Errors: -
+*/
+static int write_test_dictionary(const char *path, uint64_t *state)
+{
+    FILE *file = fopen(path, "w");
+    if (file == 0) {
+        return 0;
+    }
+    for (int len = MIN_LEN; len <= MAX_LEN; len++) {
+        for (int n = 0; n < WORDS_PER_LENGTH; n++) {
+            for (int i = 0; i < len; i++) {
+                fputc(random_letter(state) - 'A' + 'a', file);
+            }
+            fputc('\n', file);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+/* static void make_query(const WordBucket *bucket, uint64_t *state,
+*        TestQuery *query)
+* -----------------------------------------------
+* Makes up a query: a pattern (absent a third of the time) fixing some
+* positions, -with and -without letters that may repeat and overlap, and
+* up to MAX_QUERY_FEEDBACK feedback arguments
+*
+* bucket: bucket the query is for
+* state: generator state, updated
+* query: receives the query
+*
+* Returns: -
+* Errors: -
+*/
+static void make_query(const WordBucket *bucket, uint64_t *state,
+        TestQuery *query)
+{
+    int len = bucket->len;
+    query->hasPattern = next_random(state) % 3 != 0;
+    for (int i = 0; i < len; i++) {
+        query->pattern[i] = next_random(state) % 4 == 0
+                ? random_letter(state) : '_';
+    }
+    query->pattern[len] = '\0';
+    int withCount = next_random(state) % (MAX_QUERY_LETTERS + 1);
+    for (int i = 0; i < withCount; i++) {
+        query->with[i] = random_letter(state);
+    }
+    query->with[withCount] = '\0';
+    int withoutCount = next_random(state) % (MAX_QUERY_LETTERS + 1);
+    for (int i = 0; i < withoutCount; i++) {
+        query->without[i] = random_letter(state);
+    }
+    query->without[withoutCount] = '\0';
+    query->feedbackCount = next_random(state) % (MAX_QUERY_FEEDBACK + 1);
+    for (int i = 0; i < query->feedbackCount; i++) {
+        make_feedback(bucket, state, query->feedback[i]);
+    }
+}
+
+/* static void make_feedback(const WordBucket *bucket, uint64_t *state,
+*        char *feedback)
+* -----------------------------------------------
+* Makes up a feedback argument for a random guess. Half the time the marks
+* are the ones some word of the bucket gives, so the query matches
+* something; otherwise they are random and often contradict each other.
+*
+* bucket: bucket the feedback is for
+* state: generator state, updated
+* feedback: receives the argument, as in "CRANE:BYBBG"
+*
+* Returns: -
+* Errors: -
+*/
+static void make_feedback(const WordBucket *bucket, uint64_t *state,
+        char *feedback)
+{
+    int len = bucket->len;
+    for (int i = 0; i < len; i++) {
+        feedback[i] = random_letter(state);
+    }
+    feedback[len] = '\0';
+    uint32_t code = 0;
+    if (next_random(state) % 2) {
+        uint32_t answer = next_random(state) % bucket->count;
+        code = get_feedback_code(feedback,
+                bucket->words + (size_t) answer * (len + 1), len);
+    } else {
+        for (int i = 0; i < len; i++) {
+            code = code * 3 + next_random(state) % 3;
+        }
+    }
+    feedback[len] = ':';
+    for (int i = 0; i < len; i++) {
+        feedback[len + 1 + i] = "BYG"[code % 3];
+        code /= 3;
+    }
+    feedback[2 * len + 1] = '\0';
+}
+
+/* static int gives_feedback(const char *word, const TestQuery *query)
+* -----------------------------------------------
+* Checks whether a word, as the answer, gives every guess of the query
+* exactly the marks the query has for it
+*
+* word: the word
+* query: the query
+*
+* Returns: 1 if it does, 0 otherwise
+* Errors: -
+*/
+static int gives_feedback(const char *word, const TestQuery *query)
+{
+    int len = strlen(word);
+    for (int i = 0; i < query->feedbackCount; i++) {
+        const char *marks = query->feedback[i] + len + 1;
+        uint32_t code = 0;
+        for (int pos = len - 1; pos >= 0; pos--) {
+            code = code * 3 + (marks[pos] == 'G' ? 2 : marks[pos] == 'Y');
+        }
+        if (get_feedback_code(query->feedback[i], word, len) != code) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* static int check_query(const WordBucket *bucket, const TestQuery *query,
+*        int ordered)
+* -----------------------------------------------
+* Runs a query through the column kernel, the positional bitsets and the
+* candidate filter and checks each against the reference filters and the
+* feedback marks
+*
+* bucket: bucket the query is for
+* query: the query
+* ordered: if set, the tests of the query are sampled and reordered first
+*
+* Returns: 0 if every answer is right, 1 otherwise
+* Errors: -
+*/
+static int check_query(const WordBucket *bucket, const TestQuery *query,
+        int ordered)
+{
+    char pattern[MAX_LEN + 1], with[MAX_QUERY_LETTERS + 1],
+            without[MAX_QUERY_LETTERS + 1];
+    strcpy(pattern, query->pattern);
+    strcpy(with, query->with);
+    strcpy(without, query->without);
+    uint32_t *expected = malloc(bucket->count * sizeof(uint32_t));
+    uint32_t *ids = malloc(bucket->count * sizeof(uint32_t));
+    int expectedCount = 0;
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        const char *word = bucket->words + (size_t) i * (bucket->len + 1);
+        int matchesPattern = 1, matchesWith = 1, matchesWithout = 0;
+        if (query->hasPattern) {
+            filter_words_matching_pattern(pattern, word, &matchesPattern);
+        }
+        filter_words_matching_with(with, word, &matchesWith);
+        filter_words_matching_without(without, word, &matchesWithout);
+        if (matchesPattern && matchesWith && !matchesWithout
+                && gives_feedback(word, query)) {
+            expected[expectedCount++] = i;
+        }
+        ids[i] = i;
+    }
+    FeedbackConstraints feedback;
+    init_feedback_constraints(&feedback);
+    for (int i = 0; i < query->feedbackCount; i++) {
+        add_feedback(&feedback, query->feedback[i]);
+    }
+    ScanFilter filter;
+    compile_scan_filter(bucket, query->hasPattern ? pattern : 0, with,
+            without, query->feedbackCount ? &feedback : 0, &filter);
+    if (ordered) {
+        order_predicates(bucket, &filter.plan);
+    }
+    uint64_t *bits = calloc(get_bitset_words(bucket->count),
+            sizeof(uint64_t));
+    CandidateList candidates;
+    int failed = 0;
+    filter_bucket_columns(bucket, &filter.plan, 0, bucket->count, bits);
+    collect_candidates(bucket, &filter, bits, &candidates);
+    failed |= compare_ids("column kernel", query, expected, expectedCount,
+            candidates.ids, candidates.count);
+    free_candidates(&candidates);
+    match_position_bitsets(bucket, &filter.plan, 0, bucket->count, bits);
+    collect_candidates(bucket, &filter, bits, &candidates);
+    failed |= compare_ids("positional bitsets", query, expected,
+            expectedCount, candidates.ids, candidates.count);
+    free_candidates(&candidates);
+    int count = filter_candidate_ids(bucket, &filter, ids, bucket->count,
+            ids);
+    failed |= compare_ids("candidate filter", query, expected, expectedCount,
+            ids, count);
+    free(bits);
+    free(ids);
+    free(expected);
+    return failed;
+}
+
+/* static int compare_ids(const char *what, const TestQuery *query,
+*        const uint32_t *expected, int expectedCount, const uint32_t *ids,
+*        int count)
+* -----------------------------------------------
+* Compares the words a filter found with the expected ones, reporting the
+* query if they differ
+*
+* what: name of the filter
+* query: the query
+* expected: IDs of the expected words, in bucket order
+* expectedCount: number of expected words
+* ids: IDs of the words found, in bucket order
+* count: number of words found
+*
+* Returns: 0 if they are the same, 1 otherwise
+* Errors: -
+*/
+static int compare_ids(const char *what, const TestQuery *query,
+        const uint32_t *expected, int expectedCount, const uint32_t *ids,
+        int count)
+{
+    if (count == expectedCount
+            && memcmp(ids, expected, count * sizeof(uint32_t)) == 0) {
+        return 0;
+    }
+    fprintf(stderr, "%s: pattern %s -with \"%s\" -without \"%s\"", what,
+            query->hasPattern ? query->pattern : "(none)", query->with,
+            query->without);
+    for (int i = 0; i < query->feedbackCount; i++) {
+        fprintf(stderr, " -feedback %s", query->feedback[i]);
+    }
+    fprintf(stderr, " (length %d): %d words, expected %d\n",
+            (int) strlen(query->pattern), count, expectedCount);
+    return 1;
+}
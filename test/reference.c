@@ -0,0 +1,112 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include "reference.h"
+
+// The original word by word filters of the pattern, -with and -without
+// arguments. The program no longer uses them; make test checks the filter
+// kernels against them.
+
+/* void filter_words_matching_pattern(char patternString[],
+*        const char dictionaryString[], int *matchesPattern)
+* -----------------------------------------------
+* Checks a word against a pattern: every letter of the pattern must be at
+* the same position of the word, underscores match any letter
+*
+* patternString: the uppercase pattern
+* dictionaryString: the uppercase word being checked, at least as long as
+*                   the pattern
+* matchesPattern: set to 1 if the word matches, 0 if it does not; left as
+*                 it was if the pattern has no letters
+*
+* Returns: -
+* Errors: -
+*/
+void filter_words_matching_pattern(char patternString[], 
+        const char dictionaryString[], int *matchesPattern) {
+    for (int i = 0; patternString[i]; i++) {
+        if (patternString[i] != '_') {
+            if (patternString[i] == dictionaryString[i]) {
+                *matchesPattern = 1;
+            } else {
+                *matchesPattern = 0;
+                break;
+            }
+        }
+    }
+}
+
+/* void filter_words_matching_with(char withString[],
+*        const char dictionaryString[], int *matchesWith)
+* -----------------------------------------------
+* Checks a word against the -with letters: a letter given n times must
+* occur at least n times in the word
+*
+* withString: the uppercase value of the -with argument
+* dictionaryString: the uppercase word being checked
+* matchesWith: set to 1 if the word has all the letters, 0 if it does not;
+*              left as it was if withString is empty
+*
+* Returns: -
+* Errors: -
+*/
+void filter_words_matching_with(char withString[],
+        const char dictionaryString[], int *matchesWith)
+{
+    for (int j = 0; withString[j]; j++) {
+        int withCount = 1;
+        int dictCount = 0;
+        char withChar = withString[j];
+        for (int k = j + 1; withString[k]; k++) {
+            if (withChar == withString[k]) {
+                withCount++;
+            }
+        }
+        for (int k = 0; dictionaryString[k]; k++) {
+            if (dictionaryString[k] == withChar) {
+                dictCount++;
+            }
+        }
+        if (dictCount >= withCount) {
+            *matchesWith = 1;
+        } else {
+            *matchesWith = 0;
+            break;
+        }
+    }
+
+}
+
+/* void filter_words_matching_without(char withoutString[],
+*        const char dictionaryString[], int *matchesWithout)
+* -----------------------------------------------
+* Checks a word against the -without letters
+*
+* withoutString: the uppercase value of the -without argument
+* dictionaryString: the uppercase word being checked
+* matchesWithout: set to 1 if the word contains any of the letters (and so
+*                 must be left out), 0 if it contains none; left as it was
+*                 if withoutString is empty
+*
+* Returns: -
+* Errors: -
+*/
+void filter_words_matching_without(char withoutString[], 
+        const char dictionaryString[], int *matchesWithout)
+{
+    for (int j = 0; withoutString[j]; j++) {
+        int dictCount = 0;
+        char withoutChar = withoutString[j];
+        for (int k = 0; dictionaryString[k]; k++) {
+            if (dictionaryString[k] == withoutChar) {
+                dictCount++;
+            }
+        }
+        if (dictCount > 0) {
+            *matchesWithout = 1;
+            break;
+        } else {
+            *matchesWithout = 0;
+        }
+    }
+}
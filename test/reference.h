@@ -0,0 +1,17 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+/*
+* Function Prototypes
+*/
+void filter_words_matching_pattern(char patternString[], 
+        const char dictionaryString[], int *matchesPattern);
+void filter_words_matching_with(char withString[],
+        const char dictionaryString[], int *matchesWith);
+void filter_words_matching_without(char withoutString[], 
+        const char dictionaryString[], int *matchesWithout);
+
+#endif
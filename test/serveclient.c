@@ -0,0 +1,58 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*
+* ./serveclient socket line...
+*
+* Connects to a wordle-helper -serve socket, sends each line, closes its
+* side of the connection and copies everything the server sends back to
+* stdout. Exits with 0 once the server closes the connection, 1 if the
+* socket cannot be reached.
+*/
+
+/* int main(int argc, char *argv[])
+* -----------------------------------------------
+* Runs the client
+*
+* argc: count of number of commandline arguments
+* argv: the array of commandline arguments stored as strings
+*
+* Returns: 0 on success, 1 otherwise
+* Errors: prints a message to stderr if the socket cannot be reached
+*/
+int main(int argc, char *argv[])
+{
+    struct sockaddr_un address;
+    if (argc < 2 || strlen(argv[1]) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Usage: serveclient socket line...\n");
+        return 1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, argv[1]);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *) &address,
+            sizeof(address)) != 0) {
+        perror("serveclient");
+        return 1;
+    }
+    FILE *to = fdopen(dup(fd), "w");
+    for (int i = 2; i < argc; i++) {
+        fprintf(to, "%s\n", argv[i]);
+    }
+    fclose(to);
+    shutdown(fd, SHUT_WR);
+    char buffer[4096];
+    ssize_t got;
+    while ((got = read(fd, buffer, sizeof(buffer))) > 0) {
+        fwrite(buffer, 1, got, stdout);
+    }
+    close(fd);
+    return 0;
+}
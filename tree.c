@@ -0,0 +1,743 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tree.h"
+#include "dictionary.h"
+#include "wordindex.h"
+#include "entropy.h"
+#include "arena.h"
+
+// A decision tree holds a whole solving strategy for one word length: each
+// node is the guess to make when the answer is one of a set of words, and
+// its children are the sets left by each feedback the guess can get. The
+// root covers every word of the length. Answering a query is a walk from
+// the root along the -feedback guesses, so it needs no scoring at all.
+//
+// Trees are built offline by -buildtree and kept in the cache directory
+// (<hash>.dt<len>), tied to the dictionary's size and modification time
+// like the index. Guesses are taken from the words still possible (the
+// "hard mode" strategy). Each set of words is solved for the fewest total
+// guesses over its words, trying the BRANCH_GUESSES highest entropy guesses
+// and keeping the cheapest; sets larger than BRANCH_MAX_WORDS just take
+// their highest entropy guess. Different guesses often leave the same set
+// of words, so solved sets are remembered by their word IDs. Guesses are
+// scored in parallel.
+
+#define TREE_MAGIC "WRDLDTR"
+#define TREE_VERSION 1
+#define BRANCH_GUESSES 3
+#define BRANCH_MAX_WORDS 1024
+// Size the table of solved sets starts with (a power of 2)
+#define INITIAL_SLOTS 4096
+
+/*
+* Struct Definitions
+*/
+// On-disk header of a tree, followed by its nodes and then its edges
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t len;
+    uint32_t nodeCount;
+    uint32_t edgeCount;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    int64_t sourceMtimeNsec;
+} TreeHeader;
+
+// Node 0 is the root. The children of a node are its edgeCount edges from
+// firstEdge on, in increasing order of feedback code; the code of a correct
+// guess has no edge.
+struct TreeNode {
+    char guess[MAX_LEN + 1];
+    uint32_t firstEdge;
+    uint32_t edgeCount;
+};
+
+struct TreeEdge {
+    uint32_t code;
+    uint32_t child;
+};
+
+// A set of words whose best guess is known, and the total number of
+// guesses it takes to solve every word of the set
+typedef struct {
+    const uint32_t *ids;
+    int count;
+    uint64_t hash;
+    uint32_t guess;
+    uint64_t cost;
+} SolvedSet;
+
+typedef struct {
+    const WordBucket *bucket;
+    int threads;
+    uint32_t solvedCode;
+    // Solved sets, found through an open addressing table of indices + 1
+    SolvedSet *solved;
+    size_t solvedCount;
+    size_t solvedCapacity;
+    size_t *slots;
+    size_t slotCount;
+    Arena arena;
+    TreeNode *nodes;
+    uint32_t nodeCount;
+    uint32_t nodeCapacity;
+    TreeEdge *edges;
+    uint32_t edgeCount;
+    uint32_t edgeCapacity;
+    uint64_t totalGuesses;
+    int maxGuesses;
+} TreeBuilder;
+
+// What write_tree_file() writes
+typedef struct {
+    const TreeHeader *header;
+    const TreeBuilder *builder;
+} TreeFile;
+
+/*
+* Function Prototypes
+*/
+static int build_decision_tree(const WordBucket *bucket, int threads,
+        const struct stat *source, const char *treePath);
+static uint64_t solve_set(TreeBuilder *builder, const uint32_t *ids,
+        int count, uint32_t *guess);
+static int pick_guesses(const TreeBuilder *builder, const uint32_t *ids,
+        int count, uint32_t *guesses);
+static int split_by_feedback(const TreeBuilder *builder, uint32_t guess,
+        const uint32_t *ids, int count, uint32_t *parts, uint32_t *codes,
+        int *starts);
+static int compare_keys(const void *key1, const void *key2);
+static const SolvedSet *find_solved(const TreeBuilder *builder,
+        const uint32_t *ids, int count, uint64_t hash);
+static void remember_solved(TreeBuilder *builder, const uint32_t *ids,
+        int count, uint64_t hash, uint32_t guess, uint64_t cost);
+static uint32_t add_tree_node(TreeBuilder *builder, const uint32_t *ids,
+        int count, int depth);
+static int write_tree_file(FILE *file, const void *context);
+static int get_tree_path(int len, char *sourcePath, char *treePath,
+        struct stat *source);
+
+/* int build_decision_trees(int len, int threads)
+* -----------------------------------------------
+* Builds and caches the decision tree of one word length, or of every
+* length, printing a summary of each tree
+*
+* len: the word length, or 0 for every length
+* threads: maximum number of threads to score guesses with
+*
+* Returns: 0 if every tree was built, TREE_ERROR_STATUS if there is no
+*          cache to keep them in
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+int build_decision_trees(int len, int threads)
+{
+    WordIndex *index = open_word_index(len);
+    int status = 0;
+    for (int treeLen = MIN_LEN; treeLen <= MAX_LEN && !status; treeLen++) {
+        if (len && treeLen != len) {
+            continue;
+        }
+        char sourcePath[PATH_MAX], treePath[PATH_MAX];
+        struct stat source;
+        if (!get_tree_path(treeLen, sourcePath, treePath, &source)) {
+            fprintf(stderr, "wordle-helper: no cache directory to keep the "
+                    "decision trees in\n");
+            status = TREE_ERROR_STATUS;
+            break;
+        }
+        status = build_decision_tree(get_word_bucket(index, treeLen),
+                threads, &source, treePath);
+    }
+    close_word_index(index);
+    return status;
+}
+
+/* int print_tree_guess(int len, const FeedbackConstraints *feedback,
+*        OutputWriter *out)
+* -----------------------------------------------
+* Prints the next guess of the cached decision tree, following the -feedback
+* guesses down from the root
+*
+* len: the word length
+* feedback: the feedback so far, or NULL before the first guess
+* out: where the guess is printed
+*
+* Returns: 0 if a guess was printed, 4 if the feedback does not follow the
+*          tree (a guess other than the tree's, marks no word of the
+*          dictionary would get, or a guess that was already right), or
+*          TREE_ERROR_STATUS if no tree has been built for the dictionary
+* Errors: -
+*/
+int print_tree_guess(int len, const FeedbackConstraints *feedback,
+        OutputWriter *out)
+{
+    DecisionTree tree;
+    if (!open_decision_tree(len, &tree)) {
+        return TREE_ERROR_STATUS;
+    }
+    int guessCount = feedback ? feedback->guessCount : 0;
+    int node = tree.nodeCount && guessCount <= MAX_FEEDBACK_HISTORY ? 0 : -1;
+    for (int i = 0; i < guessCount && node >= 0; i++) {
+        node = strcmp(get_tree_guess(&tree, node), feedback->guesses[i]) == 0
+                ? follow_decision_tree(&tree, node, feedback->codes[i]) : -1;
+    }
+    if (node >= 0) {
+        write_word(out, get_tree_guess(&tree, node), len);
+    }
+    close_decision_tree(&tree);
+    return node >= 0 ? 0 : 4;
+}
+
+/* int open_decision_tree(int len, DecisionTree *tree)
+* -----------------------------------------------
+* Maps the cached decision tree of a word length, if it was built for the
+* dictionary as it is now
+*
+* len: the word length
+* tree: receives the tree; release with close_decision_tree()
+*
+* Returns: 1 if the tree was mapped, 0 if there is no valid tree
+* Errors: -
+*/
+int open_decision_tree(int len, DecisionTree *tree)
+{
+    char sourcePath[PATH_MAX], treePath[PATH_MAX];
+    struct stat source, st;
+    TreeHeader header;
+    if (!get_tree_path(len, sourcePath, treePath, &source)) {
+        return 0;
+    }
+    int fd = open(treePath, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0
+            || pread(fd, &header, sizeof(header), 0) != sizeof(header)
+            || memcmp(header.magic, TREE_MAGIC, sizeof(header.magic)) != 0
+            || header.version != TREE_VERSION || header.len != (uint32_t) len
+            || header.sourceSize != (uint64_t) source.st_size
+            || header.sourceMtime != source.st_mtim.tv_sec
+            || header.sourceMtimeNsec != source.st_mtim.tv_nsec
+            || header.nodeCount > INT32_MAX
+            || (uint64_t) st.st_size != sizeof(header)
+            + (uint64_t) header.nodeCount * sizeof(TreeNode)
+            + (uint64_t) header.edgeCount * sizeof(TreeEdge)) {
+        close(fd);
+        return 0;
+    }
+    void *mapping = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return 0;
+    }
+    tree->nodeCount = header.nodeCount;
+    tree->edgeCount = header.edgeCount;
+    tree->nodes = (const TreeNode *) ((char *) mapping + sizeof(header));
+    tree->edges = (const TreeEdge *) (tree->nodes + header.nodeCount);
+    tree->mapping = mapping;
+    tree->mappingSize = st.st_size;
+    return 1;
+}
+
+/* const char *get_tree_guess(const DecisionTree *tree, int node)
+* -----------------------------------------------
+* Looks up the guess of a node
+*
+* tree: the tree
+* node: the node (0 for the root)
+*
+* Returns: the NUL terminated guess
+* Errors: -
+*/
+const char *get_tree_guess(const DecisionTree *tree, int node)
+{
+    return tree->nodes[node].guess;
+}
+
+/* int follow_decision_tree(const DecisionTree *tree, int node,
+*        uint32_t code)
+* -----------------------------------------------
+* Moves down the tree from a node along the feedback its guess got, with a
+* binary search of the node's children
+*
+* tree: the tree
+* node: the node
+* code: the feedback code (see entropy.c)
+*
+* Returns: the child node, or -1 if the guess was right or no word of the
+*          dictionary gets that feedback
+* Errors: -
+*/
+int follow_decision_tree(const DecisionTree *tree, int node, uint32_t code)
+{
+    const TreeNode *parent = &tree->nodes[node];
+    if ((uint64_t) parent->firstEdge + parent->edgeCount > tree->edgeCount) {
+        return -1;
+    }
+    uint32_t low = parent->firstEdge;
+    uint32_t high = parent->firstEdge + parent->edgeCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (tree->edges[middle].code < code) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < parent->firstEdge + parent->edgeCount
+            && tree->edges[low].code == code
+            && tree->edges[low].child < tree->nodeCount) {
+        return tree->edges[low].child;
+    }
+    return -1;
+}
+
+/* void close_decision_tree(DecisionTree *tree)
+* -----------------------------------------------
+* Unmaps a tree opened by open_decision_tree()
+*
+* tree: the tree
+*
+* Returns: -
+* Errors: -
+*/
+void close_decision_tree(DecisionTree *tree)
+{
+    munmap(tree->mapping, tree->mappingSize);
+}
+
+/* static int build_decision_tree(const WordBucket *bucket, int threads,
+*        const struct stat *source, const char *treePath)
+* -----------------------------------------------
+* Builds the decision tree of a bucket and writes it to the cache
+*
+* bucket: the words of the tree's length
+* threads: maximum number of threads to score guesses with
+* source: stat() of the dictionary
+* treePath: path of the cached tree
+*
+* Returns: 0 once the tree is written, TREE_ERROR_STATUS if it cannot be
+* Errors: -
+*/
+static int build_decision_tree(const WordBucket *bucket, int threads,
+        const struct stat *source, const char *treePath)
+{
+    TreeBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.bucket = bucket;
+    builder.threads = threads;
+    for (int pos = 0; pos < bucket->len; pos++) {
+        builder.solvedCode = builder.solvedCode * 3 + 2;
+    }
+    builder.slotCount = INITIAL_SLOTS;
+    builder.slots = calloc(builder.slotCount, sizeof(size_t));
+    init_arena(&builder.arena);
+    uint32_t *ids = malloc(bucket->count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < bucket->count; i++) {
+        ids[i] = i;
+    }
+    if (bucket->count) {
+        add_tree_node(&builder, ids, bucket->count, 1);
+    }
+    free(ids);
+    TreeHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TREE_MAGIC, sizeof(header.magic));
+    header.version = TREE_VERSION;
+    header.len = bucket->len;
+    header.nodeCount = builder.nodeCount;
+    header.edgeCount = builder.edgeCount;
+    header.sourceSize = source->st_size;
+    header.sourceMtime = source->st_mtim.tv_sec;
+    header.sourceMtimeNsec = source->st_mtim.tv_nsec;
+    int status = 0;
+    TreeFile treeFile = {&header, &builder};
+    if (!write_cache_file(treePath, write_tree_file, &treeFile)) {
+        fprintf(stderr, "wordle-helper: unable to write \"%s\"\n", treePath);
+        status = TREE_ERROR_STATUS;
+    } else {
+        printf("len %d: %u words, %.3f guesses on average, at most %d\n",
+                bucket->len, bucket->count, bucket->count
+                ? (double) builder.totalGuesses / bucket->count : 0.0,
+                builder.maxGuesses);
+    }
+    free(builder.nodes);
+    free(builder.edges);
+    free(builder.solved);
+    free(builder.slots);
+    free_arena(&builder.arena);
+    return status;
+}
+
+/* static uint64_t solve_set(TreeBuilder *builder, const uint32_t *ids,
+*        int count, uint32_t *guess)
+* -----------------------------------------------
+* Finds the guess that solves a set of words in the fewest total guesses,
+* among the highest entropy guesses of the set
+*
+* builder: the tree being built
+* ids: the words, in increasing order
+* count: number of words (greater than 0)
+* guess: receives the best guess
+*
+* Returns: the total number of guesses the set takes
+* Errors: -
+*/
+static uint64_t solve_set(TreeBuilder *builder, const uint32_t *ids,
+        int count, uint32_t *guess)
+{
+    if (count <= 2) {
+        // Guess one word; if it is wrong the other takes a second guess
+        *guess = ids[0];
+        return count == 1 ? 1 : 3;
+    }
+    uint64_t hash = hash_bytes(ids, count * sizeof(uint32_t));
+    const SolvedSet *known = find_solved(builder, ids, count, hash);
+    if (known) {
+        *guess = known->guess;
+        return known->cost;
+    }
+    uint32_t options[BRANCH_GUESSES];
+    int optionCount = pick_guesses(builder, ids, count, options);
+    uint32_t *parts = malloc(count * sizeof(uint32_t));
+    uint32_t *codes = malloc(count * sizeof(uint32_t));
+    int *starts = malloc((count + 1) * sizeof(int));
+    uint64_t best = UINT64_MAX;
+    for (int option = 0; option < optionCount; option++) {
+        int groupCount = split_by_feedback(builder, options[option], ids,
+                count, parts, codes, starts);
+        uint64_t cost = count;
+        for (int group = 0; group < groupCount && cost < best; group++) {
+            uint32_t childGuess;
+            if (codes[group] != builder->solvedCode) {
+                cost += solve_set(builder, parts + starts[group],
+                        starts[group + 1] - starts[group], &childGuess);
+            }
+        }
+        if (cost < best) {
+            best = cost;
+            *guess = options[option];
+        }
+    }
+    free(starts);
+    free(codes);
+    free(parts);
+    remember_solved(builder, ids, count, hash, *guess, best);
+    return best;
+}
+
+/* static int pick_guesses(const TreeBuilder *builder, const uint32_t *ids,
+*        int count, uint32_t *guesses)
+* -----------------------------------------------
+* Picks the words of a set worth trying as its guess: those whose feedback
+* has the highest entropy over the set, alphabetically among equals
+*
+* builder: the tree being built
+* ids: the words of the set
+* count: number of words
+* guesses: receives up to BRANCH_GUESSES guesses, best first
+*
+* Returns: the number of guesses picked
+* Errors: -
+*/
+static int pick_guesses(const TreeBuilder *builder, const uint32_t *ids,
+        int count, uint32_t *guesses)
+{
+    const WordBucket *bucket = builder->bucket;
+    int stride = bucket->len + 1;
+    int wanted = count > BRANCH_MAX_WORDS ? 1 : BRANCH_GUESSES;
+    double *entropies = malloc(count * sizeof(double));
+    double picked[BRANCH_GUESSES];
+    int pickedCount = 0;
+    score_guess_entropies(bucket, ids, count, ids, count, builder->threads,
+            entropies);
+    for (int i = 0; i < count; i++) {
+        // Insertion into the short list of the best guesses so far
+        int at = pickedCount;
+        while (at > 0 && (entropies[i] > picked[at - 1]
+                || (entropies[i] == picked[at - 1]
+                && strcmp(bucket->words + (size_t) ids[i] * stride,
+                bucket->words + (size_t) guesses[at - 1] * stride) < 0))) {
+            at--;
+        }
+        if (at == wanted) {
+            continue;
+        }
+        int last = pickedCount < wanted ? pickedCount++ : wanted - 1;
+        for (int j = last; j > at; j--) {
+            picked[j] = picked[j - 1];
+            guesses[j] = guesses[j - 1];
+        }
+        picked[at] = entropies[i];
+        guesses[at] = ids[i];
+    }
+    free(entropies);
+    return pickedCount;
+}
+
+/* static int split_by_feedback(const TreeBuilder *builder, uint32_t guess,
+*        const uint32_t *ids, int count, uint32_t *parts, uint32_t *codes,
+*        int *starts)
+* -----------------------------------------------
+* Groups the words of a set by the feedback a guess gets against them
+*
+* builder: the tree being built
+* guess: the guess
+* ids: the words, in increasing order
+* count: number of words
+* parts: receives the words grouped by feedback code, groups in increasing
+*        order of code and each group in increasing order
+* codes: receives the feedback code of each group
+* starts: receives where each group starts in parts, and count after the
+*         last group
+*
+* Returns: the number of groups
+* Errors: -
+*/
+static int split_by_feedback(const TreeBuilder *builder, uint32_t guess,
+        const uint32_t *ids, int count, uint32_t *parts, uint32_t *codes,
+        int *starts)
+{
+    const WordBucket *bucket = builder->bucket;
+    int stride = bucket->len + 1;
+    const char *guessWord = bucket->words + (size_t) guess * stride;
+    uint64_t *keys = malloc(count * sizeof(uint64_t));
+    for (int i = 0; i < count; i++) {
+        uint64_t code = get_feedback_code(guessWord,
+                bucket->words + (size_t) ids[i] * stride, bucket->len);
+        keys[i] = code << 32 | ids[i];
+    }
+    qsort(keys, count, sizeof(uint64_t), compare_keys);
+    int groupCount = 0;
+    for (int i = 0; i < count; i++) {
+        parts[i] = (uint32_t) keys[i];
+        if (i == 0 || keys[i] >> 32 != keys[i - 1] >> 32) {
+            codes[groupCount] = keys[i] >> 32;
+            starts[groupCount++] = i;
+        }
+    }
+    starts[groupCount] = count;
+    free(keys);
+    return groupCount;
+}
+
+/* static int compare_keys(const void *key1, const void *key2)
+* -----------------------------------------------
+* qsort() comparator of 64-bit keys
+*
+* key1, key2: the keys
+*
+* Returns: negative, zero or positive as for strcmp()
+* Errors: -
+*/
+static int compare_keys(const void *key1, const void *key2)
+{
+    uint64_t a = *(const uint64_t *) key1;
+    uint64_t b = *(const uint64_t *) key2;
+    return (a > b) - (a < b);
+}
+
+/* static const SolvedSet *find_solved(const TreeBuilder *builder,
+*        const uint32_t *ids, int count, uint64_t hash)
+* -----------------------------------------------
+* Looks up a set of words that has been solved before
+*
+* builder: the tree being built
+* ids: the words of the set, in increasing order
+* count: number of words
+* hash: hash_bytes() of the IDs of the set
+*
+* Returns: the solved set, or NULL if it has not been solved
+* Errors: -
+*/
+static const SolvedSet *find_solved(const TreeBuilder *builder,
+        const uint32_t *ids, int count, uint64_t hash)
+{
+    size_t mask = builder->slotCount - 1;
+    for (size_t slot = hash & mask; builder->slots[slot];
+            slot = (slot + 1) & mask) {
+        const SolvedSet *set = &builder->solved[builder->slots[slot] - 1];
+        if (set->hash == hash && set->count == count
+                && memcmp(set->ids, ids, count * sizeof(uint32_t)) == 0) {
+            return set;
+        }
+    }
+    return 0;
+}
+
+/* static void remember_solved(TreeBuilder *builder, const uint32_t *ids,
+*        int count, uint64_t hash, uint32_t guess, uint64_t cost)
+* -----------------------------------------------
+* Records the best guess of a set of words, growing the table of solved
+* sets to keep it at most half full
+*
+* builder: the tree being built
+* ids: the words of the set, in increasing order (copied)
+* count: number of words
+* hash: hash_bytes() of the IDs of the set
+* guess: the set's best guess
+* cost: the total number of guesses the set takes
+*
+* Returns: -
+* Errors: -
+*/
+static void remember_solved(TreeBuilder *builder, const uint32_t *ids,
+        int count, uint64_t hash, uint32_t guess, uint64_t cost)
+{
+    if (builder->solvedCount == builder->solvedCapacity) {
+        builder->solvedCapacity = builder->solvedCapacity
+                ? builder->solvedCapacity * 2 : INITIAL_SLOTS / 2;
+        builder->solved = realloc(builder->solved,
+                builder->solvedCapacity * sizeof(SolvedSet));
+    }
+    if (2 * (builder->solvedCount + 1) > builder->slotCount) {
+        free(builder->slots);
+        builder->slotCount *= 2;
+        builder->slots = calloc(builder->slotCount, sizeof(size_t));
+        size_t mask = builder->slotCount - 1;
+        for (size_t i = 0; i < builder->solvedCount; i++) {
+            size_t slot = builder->solved[i].hash & mask;
+            while (builder->slots[slot]) {
+                slot = (slot + 1) & mask;
+            }
+            builder->slots[slot] = i + 1;
+        }
+    }
+    uint32_t *copy = arena_alloc(&builder->arena, count * sizeof(uint32_t));
+    memcpy(copy, ids, count * sizeof(uint32_t));
+    SolvedSet *set = &builder->solved[builder->solvedCount++];
+    set->ids = copy;
+    set->count = count;
+    set->hash = hash;
+    set->guess = guess;
+    set->cost = cost;
+    size_t mask = builder->slotCount - 1;
+    size_t slot = hash & mask;
+    while (builder->slots[slot]) {
+        slot = (slot + 1) & mask;
+    }
+    builder->slots[slot] = builder->solvedCount;
+}
+
+/* static uint32_t add_tree_node(TreeBuilder *builder, const uint32_t *ids,
+*        int count, int depth)
+* -----------------------------------------------
+* Adds the node of a set of words and, below it, the nodes of the sets its
+* guess leaves
+*
+* builder: the tree being built
+* ids: the words of the set, in increasing order
+* count: number of words (greater than 0)
+* depth: number of the guess made at the node (1 at the root)
+*
+* Returns: the index of the node
+* Errors: -
+*/
+static uint32_t add_tree_node(TreeBuilder *builder, const uint32_t *ids,
+        int count, int depth)
+{
+    const WordBucket *bucket = builder->bucket;
+    uint32_t guess;
+    solve_set(builder, ids, count, &guess);
+    if (builder->nodeCount == builder->nodeCapacity) {
+        builder->nodeCapacity = builder->nodeCapacity
+                ? builder->nodeCapacity * 2 : bucket->count;
+        builder->nodes = realloc(builder->nodes,
+                builder->nodeCapacity * sizeof(TreeNode));
+    }
+    uint32_t node = builder->nodeCount++;
+    memset(&builder->nodes[node], 0, sizeof(TreeNode));
+    memcpy(builder->nodes[node].guess,
+            bucket->words + (size_t) guess * (bucket->len + 1), bucket->len);
+    // The guess is always one of the words, solved at this depth
+    builder->totalGuesses += depth;
+    if (depth > builder->maxGuesses) {
+        builder->maxGuesses = depth;
+    }
+    uint32_t *parts = malloc(count * sizeof(uint32_t));
+    uint32_t *codes = malloc(count * sizeof(uint32_t));
+    int *starts = malloc((count + 1) * sizeof(int));
+    int groupCount = split_by_feedback(builder, guess, ids, count, parts,
+            codes, starts);
+    uint32_t firstEdge = builder->edgeCount;
+    uint32_t edgeCount = groupCount - 1;
+    if (builder->edgeCount + edgeCount > builder->edgeCapacity) {
+        builder->edgeCapacity = builder->edgeCapacity * 2 + edgeCount;
+        builder->edges = realloc(builder->edges,
+                builder->edgeCapacity * sizeof(TreeEdge));
+    }
+    builder->edgeCount += edgeCount;
+    builder->nodes[node].firstEdge = firstEdge;
+    builder->nodes[node].edgeCount = edgeCount;
+    uint32_t edge = firstEdge;
+    for (int group = 0; group < groupCount; group++) {
+        if (codes[group] == builder->solvedCode) {
+            continue;
+        }
+        uint32_t child = add_tree_node(builder, parts + starts[group],
+                starts[group + 1] - starts[group], depth + 1);
+        builder->edges[edge].code = codes[group];
+        builder->edges[edge++].child = child;
+    }
+    free(starts);
+    free(codes);
+    free(parts);
+    return node;
+}
+
+/* static int write_tree_file(FILE *file, const void *context)
+* -----------------------------------------------
+* Writes a built tree to its cache file (see write_cache_file())
+*
+* file: the file being written
+* context: the TreeFile to write
+*
+* Returns: 1 if every write succeeded, 0 otherwise
+* Errors: -
+*/
+static int write_tree_file(FILE *file, const void *context)
+{
+    const TreeFile *treeFile = context;
+    const TreeBuilder *builder = treeFile->builder;
+    return fwrite(treeFile->header, sizeof(*treeFile->header), 1, file) == 1
+            && fwrite(builder->nodes, sizeof(TreeNode), builder->nodeCount,
+            file) == builder->nodeCount
+            && fwrite(builder->edges, sizeof(TreeEdge), builder->edgeCount,
+            file) == builder->edgeCount;
+}
+
+/* static int get_tree_path(int len, char *sourcePath, char *treePath,
+*        struct stat *source)
+* -----------------------------------------------
+* Works out where the tree of a word length lives in the cache
+*
+* len: the word length
+* sourcePath: buffer of PATH_MAX bytes that receives the absolute path of
+*             the dictionary
+* treePath: buffer of PATH_MAX bytes that receives the path of the tree
+* source: receives stat() of the dictionary
+*
+* Returns: 1 on success, 0 if the dictionary cannot be accessed or there is
+*          no cache directory
+* Errors: -
+*/
+static int get_tree_path(int len, char *sourcePath, char *treePath,
+        struct stat *source)
+{
+    char extension[16];
+    snprintf(extension, sizeof(extension), "dt%d", len);
+    return realpath(get_dictionary_path(), sourcePath)
+            && stat(sourcePath, source) == 0
+            && get_cache_path(sourcePath, extension, treePath, PATH_MAX);
+}
@@ -0,0 +1,43 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef TREE_H
+#define TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "feedback.h"
+#include "output.h"
+
+// Exit code of -buildtree when there is no cache to keep the trees in, and
+// of -tree when no tree has been built for the dictionary
+#define TREE_ERROR_STATUS 5
+
+/*
+* Struct Definitions
+*/
+typedef struct TreeNode TreeNode;
+typedef struct TreeEdge TreeEdge;
+
+// A cached decision tree mapped into memory
+typedef struct {
+    uint32_t nodeCount;
+    uint32_t edgeCount;
+    const TreeNode *nodes;
+    const TreeEdge *edges;
+    void *mapping;
+    size_t mappingSize;
+} DecisionTree;
+
+/*
+* Function Prototypes
+*/
+int build_decision_trees(int len, int threads);
+int print_tree_guess(int len, const FeedbackConstraints *feedback,
+        OutputWriter *out);
+int open_decision_tree(int len, DecisionTree *tree);
+const char *get_tree_guess(const DecisionTree *tree, int node);
+int follow_decision_tree(const DecisionTree *tree, int node, uint32_t code);
+void close_decision_tree(DecisionTree *tree);
+
+#endif
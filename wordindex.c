@@ -0,0 +1,609 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dictionary.h"
+#include "wordindex.h"
+#include "bitsetindex.h"
+#include "stats.h"
+
+#define INDEX_MAGIC "WRDLIDX"
+#define INDEX_VERSION 5
+#define INDEX_ALIGN 8
+#define CACHE_SUBDIR "wordle-helper"
+
+/*
+* Struct Definitions
+*/
+// On-disk header of a cached index. The source path follows the header and
+// the bucket data follows the path. The words, packed words, masks,
+// counts, columns and positional bitsets of each bucket start at the given
+// offsets from the start of the file.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t pathLen;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    int64_t sourceMtimeNsec;
+    IndexCounters counters;
+    uint32_t bucketCount[MAX_LEN + 1];
+    uint64_t wordsOffset[MAX_LEN + 1];
+    uint64_t packedOffset[MAX_LEN + 1];
+    uint64_t masksOffset[MAX_LEN + 1];
+    uint64_t countsOffset[MAX_LEN + 1];
+    uint64_t columnsOffset[MAX_LEN + 1];
+    uint64_t bitsetsOffset[MAX_LEN + 1];
+} IndexHeader;
+
+// Growing bucket of packed words used while building, along with its
+// deduplication table
+typedef struct {
+    uint64_t *packed;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t *slots;
+    uint32_t slotCount;
+} BucketBuilder;
+
+// What write_index_file() writes: the header, the dictionary's absolute
+// path and the built index
+typedef struct {
+    const IndexHeader *header;
+    const char *sourcePath;
+    const WordIndex *index;
+} IndexFile;
+
+/*
+* Function Prototypes
+*/
+static WordIndex *load_cached_index(const char *cachePath,
+        const char *sourcePath, const struct stat *st, int len);
+static WordIndex *build_word_index(const Dictionary *dictionary,
+        IndexHeader *header);
+static void add_word_to_bucket(BucketBuilder *bucket, uint64_t packed,
+        IndexCounters *counters);
+static int write_index_file(FILE *file, const void *context);
+static uint32_t hash_word(const char *word, int len);
+static uint32_t hash_packed_word(uint64_t packed);
+static size_t align_up(size_t value);
+static void set_bucket(WordBucket *bucket, int len, uint32_t count,
+        const char *base, uint64_t baseOffset, const IndexHeader *header);
+
+/* WordIndex *open_word_index(int len)
+* -----------------------------------------------
+* Opens the binary index of the dictionary named by WORDLE_DICTIONARY (see
+* load_word_index())
+*
+* len: word length that will be queried, or 0 to load every bucket
+*
+* Returns: the opened index
+* Errors: exits with code 3, if the dictionary file cannot be accessed
+*/
+WordIndex *open_word_index(int len)
+{
+    const char *path = get_dictionary_path();
+    WordIndex *index = load_word_index(path, len);
+    if (index == 0) {
+        report_dictionary_error(path);
+    }
+    return index;
+}
+
+/* WordIndex *load_word_index(const char *path, int len)
+* -----------------------------------------------
+* Opens the binary index of a dictionary. If an up to date cached index
+* exists (same path, size and modification time as the dictionary), only the
+* bucket holding words of length len is loaded from it. Otherwise the text
+* dictionary is parsed, the index is built (uppercased, letters only,
+* deduplicated and bucketed by length) and written to the cache for later
+* runs.
+*
+* path: path of the dictionary file
+* len: word length that will be queried, or 0 to load every bucket
+*
+* Returns: the opened index, or NULL if the dictionary cannot be accessed
+* Errors: -
+*/
+WordIndex *load_word_index(const char *path, int len)
+{
+    char sourcePath[PATH_MAX];
+    char cachePath[PATH_MAX];
+    struct stat st;
+    int cacheable = 0;
+    uint64_t start = get_monotonic_ns();
+    if (stat(path, &st) != 0) {
+        return 0;
+    }
+    if (S_ISREG(st.st_mode) && realpath(path, sourcePath)
+            && get_cache_path(sourcePath, "idx", cachePath,
+            sizeof(cachePath))) {
+        cacheable = 1;
+        WordIndex *index = load_cached_index(cachePath, sourcePath, &st, len);
+        if (index) {
+            index->timings.readNs = get_monotonic_ns() - start;
+            return index;
+        }
+    }
+    Dictionary *dictionary = load_dictionary(path);
+    if (dictionary == 0) {
+        return 0;
+    }
+    uint64_t read = get_monotonic_ns();
+    IndexHeader header;
+    WordIndex *index = build_word_index(dictionary, &header);
+    close_dictionary(dictionary);
+    uint64_t built = get_monotonic_ns();
+    if (cacheable) {
+        header.sourceSize = st.st_size;
+        header.sourceMtime = st.st_mtim.tv_sec;
+        header.sourceMtimeNsec = st.st_mtim.tv_nsec;
+        memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+        header.version = INDEX_VERSION;
+        header.pathLen = strlen(sourcePath);
+        IndexFile indexFile = {&header, sourcePath, index};
+        write_cache_file(cachePath, write_index_file, &indexFile);
+    }
+    index->timings.readNs = read - start;
+    index->timings.buildNs = built - read;
+    index->timings.writeNs = get_monotonic_ns() - built;
+    return index;
+}
+
+/* const WordBucket *get_word_bucket(const WordIndex *index, int len)
+* -----------------------------------------------
+* Returns the bucket of words with the given length
+*
+* index: the opened index
+* len: word length (MIN_LEN to MAX_LEN)
+*
+* Returns: the bucket (which may be empty)
+* Errors: -
+*/
+const WordBucket *get_word_bucket(const WordIndex *index, int len)
+{
+    return &index->buckets[len];
+}
+
+/* void close_word_index(WordIndex *index)
+* -----------------------------------------------
+* Releases the memory (or mapping) that holds the index
+*
+* index: the index to be closed
+*
+* Returns: -
+* Errors: -
+*/
+void close_word_index(WordIndex *index)
+{
+    if (index->mapping) {
+        munmap(index->mapping, index->mappingSize);
+    }
+    free(index->built);
+    free(index);
+}
+
+/* int get_cache_path(const char *sourcePath, const char *extension,
+*        char *cachePath, size_t size)
+* -----------------------------------------------
+* Works out where a cached file for a dictionary (its index, "idx", or
+* other data derived from it) lives. The cache directory is taken from
+* WORDLE_CACHE_DIR, then $XDG_CACHE_HOME/wordle-helper, then
+* $HOME/.cache/wordle-helper. Setting WORDLE_CACHE_DIR to an empty string
+* disables the cache.
+*
+* sourcePath: absolute path of the dictionary
+* extension: file name extension of the cached file
+* cachePath: buffer that receives the path of the cached file
+* size: size of cachePath
+*
+* Returns: 1 if a usable cache directory was found, 0 otherwise
+* Errors: -
+*/
+int get_cache_path(const char *sourcePath, const char *extension,
+        char *cachePath, size_t size)
+{
+    char dir[PATH_MAX];
+    const char *env = getenv("WORDLE_CACHE_DIR");
+    if (env) {
+        if (env[0] == '\0') {
+            return 0;
+        }
+        snprintf(dir, sizeof(dir), "%s", env);
+    } else if ((env = getenv("XDG_CACHE_HOME")) && env[0]) {
+        snprintf(dir, sizeof(dir), "%s/" CACHE_SUBDIR, env);
+    } else if ((env = getenv("HOME")) && env[0]) {
+        snprintf(dir, sizeof(dir), "%s/.cache", env);
+        mkdir(dir, 0755);
+        snprintf(dir, sizeof(dir), "%s/.cache/" CACHE_SUBDIR, env);
+    } else {
+        return 0;
+    }
+    mkdir(dir, 0755);
+    if (access(dir, W_OK | X_OK) != 0) {
+        return 0;
+    }
+    uint32_t hash = hash_word(sourcePath, strlen(sourcePath));
+    return snprintf(cachePath, size, "%s/%08x.%s", dir, hash, extension)
+            < (int) size;
+}
+
+/* int write_cache_file(const char *path, CacheFileWriter writer,
+*        const void *context)
+* -----------------------------------------------
+* Writes a file of the cache under a temporary name and renames it into
+* place, so a concurrent reader sees either the old file or the whole new
+* one, never part of it. Everything kept in the cache can be worked out
+* again, so callers carry on without the file if it cannot be written.
+*
+* path: path of the cached file
+* writer: writes the contents of the file
+* context: passed on to writer
+*
+* Returns: 1 if the file was written, 0 otherwise
+* Errors: -
+*/
+int write_cache_file(const char *path, CacheFileWriter writer,
+        const void *context)
+{
+    char tmpPath[PATH_MAX];
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", path,
+            (int) getpid()) >= (int) sizeof(tmpPath)) {
+        return 0;
+    }
+    FILE *file = fopen(tmpPath, "wb");
+    if (file == 0) {
+        return 0;
+    }
+    int ok = writer(file, context);
+    if (fclose(file) != 0 || !ok || rename(tmpPath, path) != 0) {
+        unlink(tmpPath);
+        return 0;
+    }
+    return 1;
+}
+
+/* uint64_t hash_bytes(const void *data, size_t size)
+* -----------------------------------------------
+* 64-bit FNV-1a hash of a block of memory
+*
+* data: bytes to be hashed
+* size: number of bytes
+*
+* Returns: the hash value
+* Errors: -
+*/
+uint64_t hash_bytes(const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        h = (h ^ bytes[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+/* static WordIndex *load_cached_index(const char *cachePath,
+*        const char *sourcePath, const struct stat *st, int len)
+* -----------------------------------------------
+* Loads a cached index if it is still valid for the dictionary. Only the
+* requested bucket is mapped into memory.
+*
+* cachePath: path of the cached index
+* sourcePath: absolute path of the dictionary
+* st: stat() of the dictionary
+* len: length of the bucket to load, or 0 to load every bucket
+*
+* Returns: the loaded index, or NULL if there is no valid cached index
+* Errors: -
+*/
+static WordIndex *load_cached_index(const char *cachePath,
+        const char *sourcePath, const struct stat *st, int len)
+{
+    IndexHeader header;
+    char storedPath[PATH_MAX];
+    int fd = open(cachePath, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat cacheSt;
+    size_t pathLen = strlen(sourcePath);
+    if (fstat(fd, &cacheSt) != 0
+            || pread(fd, &header, sizeof(header), 0) != sizeof(header)
+            || memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0
+            || header.version != INDEX_VERSION
+            || header.sourceSize != (uint64_t) st->st_size
+            || header.sourceMtime != st->st_mtim.tv_sec
+            || header.sourceMtimeNsec != st->st_mtim.tv_nsec
+            || header.pathLen != pathLen
+            || pread(fd, storedPath, pathLen, sizeof(header))
+            != (ssize_t) pathLen
+            || memcmp(storedPath, sourcePath, pathLen) != 0) {
+        close(fd);
+        return 0;
+    }
+    // Map only the part of the file that holds the wanted bucket(s)
+    int first = len ? len : MIN_LEN;
+    int last = len ? len : MAX_LEN;
+    size_t start = header.wordsOffset[first];
+    size_t end = header.bitsetsOffset[last]
+            + get_position_bitsets_size(last, header.bucketCount[last]);
+    if (end > (size_t) cacheSt.st_size || start > end) {
+        close(fd);
+        return 0;
+    }
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t mapStart = start - start % pageSize;
+    WordIndex *index = calloc(1, sizeof(WordIndex));
+    index->counters = header.counters;
+    index->fromCache = 1;
+    if (end > mapStart) {
+        index->mappingSize = end - mapStart;
+        index->mapping = mmap(0, index->mappingSize, PROT_READ, MAP_PRIVATE,
+                fd, mapStart);
+        if (index->mapping == MAP_FAILED) {
+            close(fd);
+            free(index);
+            return 0;
+        }
+    }
+    close(fd);
+    for (int l = first; l <= last; l++) {
+        set_bucket(&index->buckets[l], l, header.bucketCount[l],
+                index->mapping, mapStart, &header);
+    }
+    return index;
+}
+
+/* static WordIndex *build_word_index(const Dictionary *dictionary,
+*        IndexHeader *header)
+* -----------------------------------------------
+* Builds the index from the text dictionary. Words outside MIN_LEN..MAX_LEN
+* and words with non-letter characters are dropped, the rest are uppercased
+* and added to the bucket for their length unless already present. The
+* buckets are laid out in one block exactly as they are stored on disk.
+*
+* dictionary: the loaded text dictionary
+* header: filled in with the bucket counts, offsets and counters
+*
+* Returns: the built index
+* Errors: -
+*/
+static WordIndex *build_word_index(const Dictionary *dictionary,
+        IndexHeader *header)
+{
+    BucketBuilder builders[MAX_LEN + 1];
+    memset(builders, 0, sizeof(builders));
+    memset(header, 0, sizeof(*header));
+    IndexCounters *counters = &header->counters;
+    size_t offset = 0;
+    int wordLen;
+    const char *word;
+    while ((word = next_dictionary_word(dictionary, &offset, &wordLen))) {
+        counters->wordsRead++;
+        if (wordLen < MIN_LEN || wordLen > MAX_LEN) {
+            counters->rejectedLength++;
+            continue;
+        }
+        int foundSpecial = 0;
+        char dictionaryString[MAX_LEN + 1];
+        memcpy(dictionaryString, word, wordLen);
+        dictionaryString[wordLen] = '\0';
+        convert_word_to_uppercase(dictionaryString, &foundSpecial);
+        if (foundSpecial) {
+            counters->rejectedNonAlpha++;
+            continue;
+        }
+        add_word_to_bucket(&builders[wordLen],
+                pack_word(dictionaryString, wordLen), counters);
+    }
+    // Lay the buckets out after the header and path, as in the cache file
+    size_t dataStart = align_up(sizeof(IndexHeader) + PATH_MAX);
+    size_t dataSize = 0;
+    for (int l = MIN_LEN; l <= MAX_LEN; l++) {
+        size_t count = builders[l].count;
+        header->bucketCount[l] = count;
+        header->wordsOffset[l] = dataStart + dataSize;
+        dataSize += align_up(count * (l + 1));
+        header->packedOffset[l] = dataStart + dataSize;
+        dataSize += count * sizeof(uint64_t);
+        header->masksOffset[l] = dataStart + dataSize;
+        dataSize += align_up(count * sizeof(uint32_t));
+        header->countsOffset[l] = dataStart + dataSize;
+        dataSize += count * sizeof(LetterCounts);
+        header->columnsOffset[l] = dataStart + dataSize;
+        dataSize += align_up(count * l);
+        header->bitsetsOffset[l] = dataStart + dataSize;
+        dataSize += get_position_bitsets_size(l, count);
+    }
+    WordIndex *index = calloc(1, sizeof(WordIndex));
+    index->counters = *counters;
+    index->built = malloc(dataSize ? dataSize : 1);
+    index->builtSize = dataSize;
+    for (int l = MIN_LEN; l <= MAX_LEN; l++) {
+        WordBucket *bucket = &index->buckets[l];
+        set_bucket(bucket, l, builders[l].count, index->built, dataStart,
+                header);
+        memcpy((uint64_t *) bucket->packed, builders[l].packed,
+                (size_t) builders[l].count * sizeof(uint64_t));
+        for (uint32_t i = 0; i < bucket->count; i++) {
+            char *word = (char *) bucket->words + (size_t) i * (l + 1);
+            unpack_word(bucket->packed[i], l, word);
+            ((uint32_t *) bucket->masks)[i] = get_letter_mask(word);
+            ((LetterCounts *) bucket->counts)[i] = get_letter_counts(word);
+            for (int pos = 0; pos < l; pos++) {
+                ((char *) bucket->columns)[(size_t) pos * bucket->count + i]
+                        = word[pos];
+            }
+        }
+        build_position_bitsets(bucket, (uint64_t *) bucket->bitsets);
+        free(builders[l].packed);
+        free(builders[l].slots);
+    }
+    return index;
+}
+
+/* static void add_word_to_bucket(BucketBuilder *bucket, uint64_t packed,
+*        IndexCounters *counters)
+* -----------------------------------------------
+* Appends a word to a bucket unless the bucket already contains it, keeping
+* the order in which words first appear in the dictionary. Words are
+* hashed and compared as packed integers.
+*
+* bucket: the bucket being built
+* packed: the packed uppercase word
+* counters: duplicate counter is updated if the word is already present
+*
+* Returns: -
+* Errors: -
+*/
+static void add_word_to_bucket(BucketBuilder *bucket, uint64_t packed,
+        IndexCounters *counters)
+{
+    // Keep the open addressing table at most half full
+    if ((bucket->count + 1) * 2 > bucket->slotCount) {
+        uint32_t slotCount = bucket->slotCount ? bucket->slotCount * 2 : 1024;
+        uint32_t *slots = calloc(slotCount, sizeof(uint32_t));
+        for (uint32_t i = 0; i < bucket->count; i++) {
+            uint32_t h = hash_packed_word(bucket->packed[i]);
+            while (slots[h & (slotCount - 1)]) {
+                h++;
+            }
+            slots[h & (slotCount - 1)] = i + 1;
+        }
+        free(bucket->slots);
+        bucket->slots = slots;
+        bucket->slotCount = slotCount;
+    }
+    uint32_t h = hash_packed_word(packed);
+    uint32_t slot;
+    while ((slot = bucket->slots[h & (bucket->slotCount - 1)])) {
+        if (bucket->packed[slot - 1] == packed) {
+            counters->duplicates++;
+            return;
+        }
+        h++;
+    }
+    if (bucket->count == bucket->capacity) {
+        bucket->capacity = bucket->capacity ? bucket->capacity * 2 : 1024;
+        bucket->packed = realloc(bucket->packed,
+                (size_t) bucket->capacity * sizeof(uint64_t));
+    }
+    bucket->packed[bucket->count++] = packed;
+    bucket->slots[h & (bucket->slotCount - 1)] = bucket->count;
+}
+
+/* static int write_index_file(FILE *file, const void *context)
+* -----------------------------------------------
+* Writes a freshly built index to its cache file (see write_cache_file())
+*
+* file: the file being written
+* context: the IndexFile to write
+*
+* Returns: 1 if every write succeeded, 0 otherwise
+* Errors: -
+*/
+static int write_index_file(FILE *file, const void *context)
+{
+    const IndexFile *indexFile = context;
+    const IndexHeader *header = indexFile->header;
+    size_t dataSize = indexFile->index->builtSize;
+    size_t dataStart = align_up(sizeof(IndexHeader) + PATH_MAX);
+    char padding[PATH_MAX];
+    memset(padding, 0, sizeof(padding));
+    size_t padLen = dataStart - sizeof(IndexHeader) - header->pathLen;
+    return fwrite(header, sizeof(*header), 1, file) == 1
+            && fwrite(indexFile->sourcePath, 1, header->pathLen, file)
+            == header->pathLen
+            && fwrite(padding, 1, padLen, file) == padLen
+            && (dataSize == 0 || fwrite(indexFile->index->built, 1,
+            dataSize, file) == dataSize);
+}
+
+/* static uint32_t hash_word(const char *word, int len)
+* -----------------------------------------------
+* FNV-1a hash of the first len bytes of word
+*
+* word: bytes to be hashed
+* len: number of bytes
+*
+* Returns: the hash value
+* Errors: -
+*/
+static uint32_t hash_word(const char *word, int len)
+{
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < len; i++) {
+        h = (h ^ (unsigned char) word[i]) * 16777619u;
+    }
+    return h;
+}
+
+/* static uint32_t hash_packed_word(uint64_t packed)
+* -----------------------------------------------
+* Fibonacci hash of a packed word, which mixes every letter into the high
+* bits that are kept
+*
+* packed: the packed word
+*
+* Returns: the hash value
+* Errors: -
+*/
+static uint32_t hash_packed_word(uint64_t packed)
+{
+    return (packed * 0x9E3779B97F4A7C15ull) >> 32;
+}
+
+/* static size_t align_up(size_t value)
+* -----------------------------------------------
+* Rounds value up to a multiple of INDEX_ALIGN
+*
+* value: value to be rounded
+*
+* Returns: the rounded value
+* Errors: -
+*/
+static size_t align_up(size_t value)
+{
+    return (value + INDEX_ALIGN - 1) & ~((size_t) INDEX_ALIGN - 1);
+}
+
+/* static void set_bucket(WordBucket *bucket, int len, uint32_t count,
+*        const char *base, uint64_t baseOffset, const IndexHeader *header)
+* -----------------------------------------------
+* Points a bucket at its words, packed words, masks, counts, columns and
+* bitsets inside a block of memory holding (part of) the index file
+*
+* bucket: bucket to be set up
+* len: word length of the bucket
+* count: number of words in the bucket
+* base: start of the block in memory
+* baseOffset: file offset that base corresponds to
+* header: header holding the file offsets of each bucket
+*
+* Returns: -
+* Errors: -
+*/
+static void set_bucket(WordBucket *bucket, int len, uint32_t count,
+        const char *base, uint64_t baseOffset, const IndexHeader *header)
+{
+    bucket->len = len;
+    bucket->count = count;
+    bucket->words = base + (header->wordsOffset[len] - baseOffset);
+    bucket->packed = (const uint64_t *) (base
+            + (header->packedOffset[len] - baseOffset));
+    bucket->masks = (const uint32_t *) (base
+            + (header->masksOffset[len] - baseOffset));
+    bucket->counts = (const LetterCounts *) (base
+            + (header->countsOffset[len] - baseOffset));
+    bucket->columns = base + (header->columnsOffset[len] - baseOffset);
+    bucket->bitsets = (const uint64_t *) (base
+            + (header->bitsetsOffset[len] - baseOffset));
+}
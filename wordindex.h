@@ -0,0 +1,77 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef WORDINDEX_H
+#define WORDINDEX_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "wordle.h"
+#include "lettermask.h"
+
+// Writes the contents of a cache file (see write_cache_file()), returning
+// 1 if every write succeeded and 0 otherwise
+typedef int (*CacheFileWriter)(FILE *file, const void *context);
+
+/*
+* Struct Definitions
+*/
+// All words of a single length. Word i is stored NUL terminated at
+// words + i * (len + 1), packed into an integer (see LETTER_BITS) at
+// packed[i], with its letter mask and packed letter counts at masks[i] and
+// counts[i]. columns holds the same letters column-major (letter pos of
+// word i at columns[pos * count + i]) and bitsets holds the positional
+// inverted index described in bitsetindex.c.
+typedef struct {
+    int len;
+    uint32_t count;
+    const char *words;
+    const uint64_t *packed;
+    const uint32_t *masks;
+    const LetterCounts *counts;
+    const char *columns;
+    const uint64_t *bitsets;
+} WordBucket;
+
+// Counters gathered while building the index from the text dictionary
+typedef struct {
+    uint64_t wordsRead;
+    uint64_t rejectedLength;
+    uint64_t rejectedNonAlpha;
+    uint64_t duplicates;
+} IndexCounters;
+
+// Time spent opening the index: reading the cached index or the text
+// dictionary, building the index from the text and writing it to the cache
+typedef struct {
+    uint64_t readNs;
+    uint64_t buildNs;
+    uint64_t writeNs;
+} IndexTimings;
+
+typedef struct {
+    WordBucket buckets[MAX_LEN + 1];
+    IndexCounters counters;
+    IndexTimings timings;
+    int fromCache;
+    void *mapping;
+    size_t mappingSize;
+    char *built;
+    size_t builtSize;
+} WordIndex;
+
+/*
+* Function Prototypes
+*/
+WordIndex *open_word_index(int len);
+WordIndex *load_word_index(const char *path, int len);
+const WordBucket *get_word_bucket(const WordIndex *index, int len);
+void close_word_index(WordIndex *index);
+int get_cache_path(const char *sourcePath, const char *extension,
+        char *cachePath, size_t size);
+int write_cache_file(const char *path, CacheFileWriter writer,
+        const void *context);
+uint64_t hash_bytes(const void *data, size_t size);
+
+#endif
@@ -0,0 +1,13 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef WORDLE_H
+#define WORDLE_H
+
+#define MAX_SIZE 10
+#define MAX_WORD_SIZE 50
+#define MIN_LEN 4
+#define MAX_LEN 9
+#define DEFAULT_LEN 5
+
+#endif
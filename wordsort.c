@@ -0,0 +1,566 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#include <string.h>
+#include "wordsort.h"
+#include "score.h"
+#include "parallel.h"
+
+// Keys are sorted 11 bits at a time, so a 9 letter word (45 bits) takes at
+// most 5 passes
+#define RADIX_BITS 11
+#define RADIX_SIZE (1 << RADIX_BITS)
+// Lists are only split for sorting on several threads once every slice
+// has at least this many words; below that the merge costs about as much
+// as the threads save
+#define MIN_SORT_CHUNK_WORDS 16384
+
+/*
+* Struct Definitions
+*/
+// Letter statistics gathered by one chunk of the first -best pass
+typedef struct {
+    const WordBucket *bucket;
+    LetterStats stats;
+} StatsChunk;
+
+// The limit smallest (key, id) pairs seen by one chunk, as a max-heap on
+// the key so the worst of them is always at the root
+typedef struct {
+    const WordBucket *bucket;
+    const ScoreTable *table;
+    int limit;
+    int count;
+    uint64_t *keys;
+    uint32_t *ids;
+} TopChunk;
+
+// One slice of a list being sorted on its own thread
+typedef struct {
+    uint64_t *keys;
+    uint32_t *ids;
+    int count;
+    int keyBits;
+} SortChunk;
+
+/*
+* Function Prototypes
+*/
+static int sort_keys(uint64_t *keys, uint32_t *ids, int count, int keyBits,
+        int threads, Arena *arena);
+static void sort_chunk(int chunk, void *context);
+static int merge_sorted_chunks(SortChunk *chunks, int chunkCount,
+        uint64_t *keys, uint32_t *ids, Arena *arena);
+static void sift_down_heads(const SortChunk *chunks, const int *heads,
+        int *heap, int heapSize, int i);
+static uint64_t get_rank_key(const WordBucket *bucket,
+        const ScoreTable *table, uint32_t id);
+static int gather_letter_stats(uint32_t id, void *state);
+static int keep_top_match(uint32_t id, void *state);
+static void sift_down_top(TopChunk *top, int i);
+
+/* int sort_candidates_alphabetically(CandidateList *candidates,
+*        int threads)
+* -----------------------------------------------
+* Sorts the candidates into alphabetical order with a radix sort on their
+* packed words, dropping duplicate words along the way
+*
+* candidates: the list to be sorted in place
+* threads: maximum number of threads to use
+*
+* Returns: the number of candidates left
+* Errors: -
+*/
+int sort_candidates_alphabetically(CandidateList *candidates, int threads)
+{
+    const WordBucket *bucket = candidates->bucket;
+    int len = bucket->len;
+    uint64_t *keys = arena_alloc(&candidates->arena,
+            candidates->count * sizeof(uint64_t));
+    for (int i = 0; i < candidates->count; i++) {
+        keys[i] = bucket->packed[candidates->ids[i]];
+    }
+    candidates->count = sort_keys(keys, candidates->ids, candidates->count,
+            len * LETTER_BITS, threads, &candidates->arena);
+    return candidates->count;
+}
+
+/* int sort_candidates_by_score(CandidateList *candidates, int threads)
+* -----------------------------------------------
+* Sorts the candidates from best to worst guess (see score_candidates()),
+* alphabetically among equal scores. The score and the packed word are
+* combined into one integer key, inverted score in the high bits, so the
+* radix sort orders by (score desc, word asc) in one go and also drops
+* duplicate words.
+*
+* candidates: the list to be sorted in place
+* threads: maximum number of threads to use
+*
+* Returns: the number of candidates left
+* Errors: -
+*/
+int sort_candidates_by_score(CandidateList *candidates, int threads)
+{
+    int len = candidates->bucket->len;
+    int wordBits = len * LETTER_BITS;
+    uint32_t *scores = arena_alloc(&candidates->arena,
+            candidates->count * sizeof(uint32_t));
+    uint64_t *keys = arena_alloc(&candidates->arena,
+            candidates->count * sizeof(uint64_t));
+    score_candidates(candidates, scores);
+    for (int i = 0; i < candidates->count; i++) {
+        uint64_t rank = ((1u << SCORE_BITS) - 1) - scores[i];
+        keys[i] = (rank << wordBits)
+                | candidates->bucket->packed[candidates->ids[i]];
+    }
+    candidates->count = sort_keys(keys, candidates->ids, candidates->count,
+            wordBits + SCORE_BITS, threads, &candidates->arena);
+    return candidates->count;
+}
+
+/* int select_top_candidates(const WordBucket *bucket,
+*        const char *patternString, const char *withString,
+*        const char *withoutString, const FeedbackConstraints *feedback,
+*        int threads, int byScore, int limit, CandidateList *candidates)
+* -----------------------------------------------
+* Finds the first limit matching words in alphabetical or -best order
+* without collecting and sorting every match. Each scan chunk keeps a
+* bounded heap of its limit best keys; only those are merged and sorted at
+* the end, so memory and sorting work grow with limit rather than with the
+* number of matches. Ranking by score takes an extra pass over the matches
+* to gather the letter statistics the scores are based on.
+*
+* bucket: the words of the requested length
+* patternString: uppercase pattern, or NULL if no pattern was given
+* withString, withoutString: uppercase -with/-without values ("" if unset)
+* feedback: constraints from -feedback, or NULL if none was given
+* threads: maximum number of threads to use
+* byScore: non-zero to rank as sort_candidates_by_score() does, zero for
+*          alphabetical order
+* limit: number of words wanted (greater than 0)
+* candidates: receives the selected words in order; release with
+*             free_candidates()
+*
+* Returns: the number of words selected
+* Errors: -
+*/
+int select_top_candidates(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, int threads, int byScore,
+        int limit, CandidateList *candidates)
+{
+    candidates->bucket = bucket;
+    init_arena(&candidates->arena);
+    Arena *arena = &candidates->arena;
+    if ((uint32_t) limit > bucket->count) {
+        limit = bucket->count;
+    }
+    int chunkCount = get_scan_chunk_count(bucket, threads);
+    ScoreTable table;
+    if (byScore) {
+        StatsChunk *stats = arena_alloc(arena, chunkCount * sizeof(*stats));
+        memset(stats, 0, chunkCount * sizeof(*stats));
+        for (int i = 0; i < chunkCount; i++) {
+            stats[i].bucket = bucket;
+        }
+        visit_matches(bucket, patternString, withString, withoutString,
+                feedback, chunkCount, gather_letter_stats, stats,
+                sizeof(*stats));
+        for (int i = 1; i < chunkCount; i++) {
+            merge_letter_stats(&stats[0].stats, &stats[i].stats);
+        }
+        build_score_table(&stats[0].stats, bucket->len, &table);
+    }
+    TopChunk *tops = arena_alloc(arena, chunkCount * sizeof(*tops));
+    for (int i = 0; i < chunkCount; i++) {
+        tops[i].bucket = bucket;
+        tops[i].table = byScore ? &table : 0;
+        tops[i].limit = limit;
+        tops[i].count = 0;
+        tops[i].keys = arena_alloc(arena, limit * sizeof(uint64_t));
+        tops[i].ids = arena_alloc(arena, limit * sizeof(uint32_t));
+    }
+    if (limit > 0) {
+        visit_matches(bucket, patternString, withString, withoutString,
+                feedback, chunkCount, keep_top_match, tops, sizeof(*tops));
+    }
+    int total = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        total += tops[i].count;
+    }
+    uint64_t *keys = arena_alloc(arena, total * sizeof(uint64_t));
+    candidates->ids = arena_alloc(arena, total * sizeof(uint32_t));
+    int count = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        memcpy(keys + count, tops[i].keys, tops[i].count * sizeof(uint64_t));
+        memcpy(candidates->ids + count, tops[i].ids,
+                tops[i].count * sizeof(uint32_t));
+        count += tops[i].count;
+    }
+    int keyBits = bucket->len * LETTER_BITS + (byScore ? SCORE_BITS : 0);
+    count = radix_sort_unique(keys, candidates->ids, count, keyBits, arena);
+    candidates->count = count < limit ? count : limit;
+    return candidates->count;
+}
+
+/* int radix_sort_unique(uint64_t *keys, uint32_t *ids, int count,
+*        int keyBits, Arena *arena)
+* -----------------------------------------------
+* LSD radix sort of (key, id) pairs on the low keyBits bits of the keys.
+* Digits that are the same in every key are skipped. Duplicate keys are
+* dropped while the last pass scatters the pairs (equal keys meet in the
+* same digit bucket), keeping the first of each run.
+*
+* keys: keys to sort, sorted in place
+* ids: ids moved along with their keys
+* count: number of pairs
+* keyBits: number of significant bits in each key
+* arena: scratch memory is allocated from here
+*
+* Returns: the number of unique keys left at the front of keys/ids
+* Errors: -
+*/
+int radix_sort_unique(uint64_t *keys, uint32_t *ids, int count, int keyBits,
+        Arena *arena)
+{
+    if (count < 2) {
+        return count;
+    }
+    int passes = (keyBits + RADIX_BITS - 1) / RADIX_BITS;
+    uint32_t (*histograms)[RADIX_SIZE] = arena_alloc(arena,
+            passes * sizeof(*histograms));
+    memset(histograms, 0, passes * sizeof(*histograms));
+    // One read of the keys builds the histograms of every pass
+    for (int i = 0; i < count; i++) {
+        for (int pass = 0; pass < passes; pass++) {
+            histograms[pass][(keys[i] >> (pass * RADIX_BITS))
+                    & (RADIX_SIZE - 1)]++;
+        }
+    }
+    int lastPass = -1;
+    for (int pass = 0; pass < passes; pass++) {
+        if (histograms[pass][keys[0] >> (pass * RADIX_BITS)
+                & (RADIX_SIZE - 1)] != (uint32_t) count) {
+            lastPass = pass;
+        }
+    }
+    if (lastPass < 0) {
+        return 1; // every key is the same
+    }
+    uint64_t *keyScratch = arena_alloc(arena, count * sizeof(uint64_t));
+    uint32_t *idScratch = arena_alloc(arena, count * sizeof(uint32_t));
+    uint64_t *fromKeys = keys, *toKeys = keyScratch;
+    uint32_t *fromIds = ids, *toIds = idScratch;
+    uint32_t starts[RADIX_SIZE];
+    uint32_t ends[RADIX_SIZE];
+    int unique = count;
+    for (int pass = 0; pass <= lastPass; pass++) {
+        uint32_t *histogram = histograms[pass];
+        if (histogram[keys[0] >> (pass * RADIX_BITS) & (RADIX_SIZE - 1)]
+                == (uint32_t) count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (int digit = 0; digit < RADIX_SIZE; digit++) {
+            starts[digit] = ends[digit] = offset;
+            offset += histogram[digit];
+        }
+        int shift = pass * RADIX_BITS;
+        for (int i = 0; i < count; i++) {
+            uint64_t key = fromKeys[i];
+            int digit = (key >> shift) & (RADIX_SIZE - 1);
+            // Fused deduplication: on the last pass equal keys are adjacent
+            // within their digit bucket
+            if (pass == lastPass && ends[digit] > starts[digit]
+                    && toKeys[ends[digit] - 1] == key) {
+                unique--;
+                continue;
+            }
+            toKeys[ends[digit]] = key;
+            toIds[ends[digit]++] = fromIds[i];
+        }
+        uint64_t *swapKeys = fromKeys;
+        fromKeys = toKeys;
+        toKeys = swapKeys;
+        uint32_t *swapIds = fromIds;
+        fromIds = toIds;
+        toIds = swapIds;
+    }
+    // Close the gaps left by dropped duplicates while copying back
+    int out = 0;
+    for (int digit = 0; digit < RADIX_SIZE; digit++) {
+        uint32_t n = ends[digit] - starts[digit];
+        if (fromKeys != keys || (uint32_t) out != starts[digit]) {
+            memmove(keys + out, fromKeys + starts[digit],
+                    n * sizeof(uint64_t));
+            memmove(ids + out, fromIds + starts[digit], n * sizeof(uint32_t));
+        }
+        out += n;
+    }
+    return unique;
+}
+
+/* static int sort_keys(uint64_t *keys, uint32_t *ids, int count,
+*        int keyBits, int threads, Arena *arena)
+* -----------------------------------------------
+* radix_sort_unique() spread over threads: a long list is cut into
+* slices that are radix sorted on their own threads and then k-way merged.
+* The merge drops keys repeated across slices, keeping the one from the
+* earliest slice, so the result is the same as sorting on one thread.
+*
+* keys: keys to sort, sorted in place
+* ids: ids moved along with their keys
+* count: number of pairs
+* keyBits: number of significant bits in each key
+* threads: maximum number of threads to use
+* arena: scratch memory is allocated from here
+*
+* Returns: the number of unique keys left at the front of keys/ids
+* Errors: -
+*/
+static int sort_keys(uint64_t *keys, uint32_t *ids, int count, int keyBits,
+        int threads, Arena *arena)
+{
+    int chunkCount = count / MIN_SORT_CHUNK_WORDS;
+    if (chunkCount > threads) {
+        chunkCount = threads;
+    }
+    if (chunkCount < 2) {
+        return radix_sort_unique(keys, ids, count, keyBits, arena);
+    }
+    SortChunk *chunks = arena_alloc(arena, chunkCount * sizeof(*chunks));
+    for (int i = 0; i < chunkCount; i++) {
+        int first = (int) ((int64_t) count * i / chunkCount);
+        int end = (int) ((int64_t) count * (i + 1) / chunkCount);
+        chunks[i].keys = keys + first;
+        chunks[i].ids = ids + first;
+        chunks[i].count = end - first;
+        chunks[i].keyBits = keyBits;
+    }
+    run_parallel(chunkCount, sort_chunk, chunks);
+    return merge_sorted_chunks(chunks, chunkCount, keys, ids, arena);
+}
+
+/* static void sort_chunk(int chunk, void *context)
+* -----------------------------------------------
+* Radix sorts one slice of a list. Runs on its own thread, with scratch
+* memory of its own.
+*
+* chunk: index of the slice
+* context: the array of SortChunk
+*
+* Returns: -
+* Errors: -
+*/
+static void sort_chunk(int chunk, void *context)
+{
+    SortChunk *sort = (SortChunk *) context + chunk;
+    Arena arena;
+    init_arena(&arena);
+    sort->count = radix_sort_unique(sort->keys, sort->ids, sort->count,
+            sort->keyBits, &arena);
+    free_arena(&arena);
+}
+
+/* static int merge_sorted_chunks(SortChunk *chunks, int chunkCount,
+*        uint64_t *keys, uint32_t *ids, Arena *arena)
+* -----------------------------------------------
+* k-way merge of sorted slices using a binary heap of slice heads, dropping
+* repeated keys
+*
+* chunks: the sorted slices, which lie inside keys/ids
+* chunkCount: number of slices
+* keys, ids: receive the merged pairs
+* arena: scratch memory is allocated from here
+*
+* Returns: the number of unique keys merged
+* Errors: -
+*/
+static int merge_sorted_chunks(SortChunk *chunks, int chunkCount,
+        uint64_t *keys, uint32_t *ids, Arena *arena)
+{
+    int total = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        total += chunks[i].count;
+    }
+    uint64_t *mergedKeys = arena_alloc(arena, total * sizeof(uint64_t));
+    uint32_t *mergedIds = arena_alloc(arena, total * sizeof(uint32_t));
+    int heads[chunkCount];
+    int heap[chunkCount];
+    int heapSize = 0;
+    for (int i = 0; i < chunkCount; i++) {
+        heads[i] = 0;
+        if (chunks[i].count > 0) {
+            heap[heapSize++] = i;
+        }
+    }
+    for (int i = heapSize / 2 - 1; i >= 0; i--) {
+        sift_down_heads(chunks, heads, heap, heapSize, i);
+    }
+    int count = 0;
+    while (heapSize > 0) {
+        SortChunk *chunk = &chunks[heap[0]];
+        int head = heads[heap[0]]++;
+        if (count == 0 || mergedKeys[count - 1] != chunk->keys[head]) {
+            mergedKeys[count] = chunk->keys[head];
+            mergedIds[count++] = chunk->ids[head];
+        }
+        if (heads[heap[0]] == chunk->count) {
+            heap[0] = heap[--heapSize];
+        }
+        sift_down_heads(chunks, heads, heap, heapSize, 0);
+    }
+    memcpy(keys, mergedKeys, count * sizeof(uint64_t));
+    memcpy(ids, mergedIds, count * sizeof(uint32_t));
+    return count;
+}
+
+/* static void sift_down_heads(const SortChunk *chunks, const int *heads,
+*        int *heap, int heapSize, int i)
+* -----------------------------------------------
+* Restores the heap property below position i. Slices are ordered by their
+* head key, ties by slice order so the earliest slice's key is kept.
+*
+* chunks: the slices being merged
+* heads: position of each slice's head key
+* heap: heap of slice indices
+* heapSize: number of entries in the heap
+* i: position to sift down from
+*
+* Returns: -
+* Errors: -
+*/
+static void sift_down_heads(const SortChunk *chunks, const int *heads,
+        int *heap, int heapSize, int i)
+{
+    while (1) {
+        int smallest = i;
+        for (int child = 2 * i + 1; child <= 2 * i + 2; child++) {
+            if (child >= heapSize) {
+                break;
+            }
+            uint64_t childKey = chunks[heap[child]].keys[heads[heap[child]]];
+            uint64_t key = chunks[heap[smallest]].keys[heads[heap[smallest]]];
+            if (childKey < key || (childKey == key
+                    && heap[child] < heap[smallest])) {
+                smallest = child;
+            }
+        }
+        if (smallest == i) {
+            return;
+        }
+        int swap = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+/* static uint64_t get_rank_key(const WordBucket *bucket,
+*        const ScoreTable *table, uint32_t id)
+* -----------------------------------------------
+* Builds the -best sort key of a word: inverted score above the packed word
+*
+* bucket: the bucket holding the word
+* table: scores of the candidate set
+* id: ID of the word
+*
+* Returns: the key
+* Errors: -
+*/
+static uint64_t get_rank_key(const WordBucket *bucket,
+        const ScoreTable *table, uint32_t id)
+{
+    const char *word = bucket->words + (size_t) id * (bucket->len + 1);
+    uint64_t rank = ((1u << SCORE_BITS) - 1)
+            - score_word(table, word, bucket->masks[id]);
+    return (rank << (bucket->len * LETTER_BITS)) | bucket->packed[id];
+}
+
+/* static int gather_letter_stats(uint32_t id, void *state)
+* -----------------------------------------------
+* Match visitor that counts the word into its chunk's letter statistics
+*
+* id: ID of the matching word
+* state: the chunk's StatsChunk
+*
+* Returns: 1 (never stops the scan)
+* Errors: -
+*/
+static int gather_letter_stats(uint32_t id, void *state)
+{
+    StatsChunk *chunk = state;
+    const WordBucket *bucket = chunk->bucket;
+    add_letter_stats(&chunk->stats,
+            bucket->words + (size_t) id * (bucket->len + 1),
+            bucket->masks[id], bucket->len);
+    return 1;
+}
+
+/* static int keep_top_match(uint32_t id, void *state)
+* -----------------------------------------------
+* Match visitor that keeps the word if it is among the chunk's limit best
+* so far, replacing the worst kept word once the heap is full
+*
+* id: ID of the matching word
+* state: the chunk's TopChunk
+*
+* Returns: 1 (never stops the scan)
+* Errors: -
+*/
+static int keep_top_match(uint32_t id, void *state)
+{
+    TopChunk *top = state;
+    const WordBucket *bucket = top->bucket;
+    uint64_t key = top->table ? get_rank_key(bucket, top->table, id)
+            : bucket->packed[id];
+    if (top->count < top->limit) {
+        int i = top->count++;
+        while (i > 0 && top->keys[(i - 1) / 2] < key) {
+            top->keys[i] = top->keys[(i - 1) / 2];
+            top->ids[i] = top->ids[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        top->keys[i] = key;
+        top->ids[i] = id;
+    } else if (key < top->keys[0]) {
+        top->keys[0] = key;
+        top->ids[0] = id;
+        sift_down_top(top, 0);
+    }
+    return 1;
+}
+
+/* static void sift_down_top(TopChunk *top, int i)
+* -----------------------------------------------
+* Restores the max-heap property of a chunk's kept keys below position i
+*
+* top: the chunk's kept words
+* i: position to sift down from
+*
+* Returns: -
+* Errors: -
+*/
+static void sift_down_top(TopChunk *top, int i)
+{
+    uint64_t key = top->keys[i];
+    uint32_t id = top->ids[i];
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= top->count) {
+            break;
+        }
+        if (child + 1 < top->count && top->keys[child + 1]
+                > top->keys[child]) {
+            child++;
+        }
+        if (top->keys[child] <= key) {
+            break;
+        }
+        top->keys[i] = top->keys[child];
+        top->ids[i] = top->ids[child];
+        i = child;
+    }
+    top->keys[i] = key;
+    top->ids[i] = id;
+}
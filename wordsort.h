@@ -0,0 +1,22 @@
+// Wordle Helper
+// Author: Rohith Kotia Palakirti
+
+#ifndef WORDSORT_H
+#define WORDSORT_H
+
+#include <stdint.h>
+#include "scan.h"
+
+/*
+* Function Prototypes
+*/
+int sort_candidates_alphabetically(CandidateList *candidates, int threads);
+int sort_candidates_by_score(CandidateList *candidates, int threads);
+int select_top_candidates(const WordBucket *bucket, const char *patternString,
+        const char *withString, const char *withoutString,
+        const FeedbackConstraints *feedback, int threads, int byScore,
+        int limit, CandidateList *candidates);
+int radix_sort_unique(uint64_t *keys, uint32_t *ids, int count, int keyBits,
+        Arena *arena);
+
+#endif